@@ -1,9 +1,10 @@
 #include <stdio.h>
 #include <memory>
-#include <map>
+#include <string>
 #include <cstdio>
 #include <cctype>
 #include <vector>
+#include <array>
 #include <cmath>
 #include <algorithm>
 
@@ -11,6 +12,7 @@
 #include "hardware/gpio.h"
 #include "AudioAPI.hpp"
 #include "PicoAudioCore.hpp"
+#include "PicoMidiUart.hpp"
 
 using namespace Audio;
 
@@ -28,50 +30,95 @@ private:
     WaveType current_wave = WaveType::PIANO;
     bool running = true;
 
-    // 简化的音符频率映射 - 只支持3个八度
-    std::map<int, std::map<int, float>> note_frequencies = {
-        // 第3八度（低音区）
-        {3, {
-            {1, 130.81f}, // C3 - 低音DO
-            {2, 146.83f}, // D3 - 低音RE
-            {3, 164.81f}, // E3 - 低音MI
-            {4, 174.61f}, // F3 - 低音FA
-            {5, 196.00f}, // G3 - 低音SOL
-            {6, 220.00f}, // A3 - 低音LA
-            {7, 246.94f}  // B3 - 低音SI
-        }},
-        // 第4八度（标准音区）
-        {4, {
-            {1, 261.63f}, // C4 - DO
-            {2, 293.66f}, // D4 - RE
-            {3, 329.63f}, // E4 - MI
-            {4, 349.23f}, // F4 - FA
-            {5, 392.00f}, // G4 - SOL
-            {6, 440.00f}, // A4 - LA
-            {7, 493.88f}  // B4 - SI
-        }},
-        // 第5八度（高音区）
-        {5, {
-            {1, 523.25f}, // C5 - 高音DO
-            {2, 587.33f}, // D5 - 高音RE
-            {3, 659.25f}, // E5 - 高音MI
-            {4, 698.46f}, // F5 - 高音FA
-            {5, 783.99f}, // G5 - 高音SOL
-            {6, 880.00f}, // A5 - 高音LA
-            {7, 987.77f}  // B5 - 高音SI
-        }}
-    };
+    // MIDI输入：DIN-5经UART中断接入；USB串口可切换为原始MIDI字节流
+    MidiInput uart_midi;
+    MidiInput usb_midi;
+    PicoMidiUart midi_uart;         // 默认UART1 RX=GP5（与pin_config.hpp一致）
+    bool usb_midi_mode = false;     // 收到0xFF（System Reset）时退出
+
+    // 数字键1-7对应的唱名，只支持3个八度（频率查Notes::PITCH_TABLE）
+    static constexpr int MIN_OCTAVE = 3;
+    static constexpr int MAX_OCTAVE = 5;
+    static constexpr const char* SOLFEGE[] = {"DO", "RE", "MI", "FA", "SOL", "LA", "SI"};
+    static constexpr const char* OCTAVE_PREFIX[] = {"低音", "", "高音"};
+
+    // 串口输入没有按键抬起事件，音符按下后保持固定时长再释放
+    static constexpr uint32_t NOTE_HOLD_MS = 400;
+    static constexpr size_t MAX_HELD_NOTES = 8;
 
-    // 音符名称映射
-    std::map<int, std::map<int, std::string>> note_names = {
-        {3, {{1, "低音DO"}, {2, "低音RE"}, {3, "低音MI"}, {4, "低音FA"}, {5, "低音SOL"}, {6, "低音LA"}, {7, "低音SI"}}},
-        {4, {{1, "DO"}, {2, "RE"}, {3, "MI"}, {4, "FA"}, {5, "SOL"}, {6, "LA"}, {7, "SI"}}},
-        {5, {{1, "高音DO"}, {2, "高音RE"}, {3, "高音MI"}, {4, "高音FA"}, {5, "高音SOL"}, {6, "高音LA"}, {7, "高音SI"}}}
+    struct HeldNote {
+        uint8_t midi_note = 0;
+        absolute_time_t release_at = {};
+        bool active = false;
     };
+    std::array<HeldNote, MAX_HELD_NOTES> held_notes{};
+
+    /**
+     * @brief 数字键（1-7）与八度转换为MIDI音符号
+     */
+    static constexpr uint8_t midiNoteFor(int note_num, int octave) {
+        constexpr uint8_t SEMITONES[] = {0, 2, 4, 5, 7, 9, 11};
+        return static_cast<uint8_t>(12 * (octave + 1) + SEMITONES[note_num - 1]);
+    }
+
+    static bool isValidNote(int note_num, int octave) {
+        return note_num >= 1 && note_num <= 7 && octave >= MIN_OCTAVE && octave <= MAX_OCTAVE;
+    }
+
+    /**
+     * @brief 显示用音符名（如"低音SOL"）
+     */
+    static std::string noteName(int note_num, int octave) {
+        return std::string(OCTAVE_PREFIX[octave - MIN_OCTAVE]) + SOLFEGE[note_num - 1];
+    }
+
+    /**
+     * @brief 记录按下的音符，到时后自动释放
+     */
+    void holdNote(uint8_t midi_note) {
+        HeldNote* slot = nullptr;
+        for (auto& held : held_notes) {
+            if (held.active && held.midi_note == midi_note) {
+                slot = &held;
+                break;
+            }
+            if (!held.active && !slot) {
+                slot = &held;
+            }
+        }
+        if (!slot) {
+            // 已满：提前释放最早到期的音符
+            slot = &held_notes[0];
+            for (auto& held : held_notes) {
+                if (absolute_time_diff_us(held.release_at, slot->release_at) > 0) {
+                    slot = &held;
+                }
+            }
+            audio_api->noteOff(slot->midi_note);
+        }
+        slot->midi_note = midi_note;
+        slot->release_at = make_timeout_time_ms(NOTE_HOLD_MS);
+        slot->active = true;
+    }
+
+    /**
+     * @brief 释放已到期的音符
+     */
+    void releaseExpiredNotes() {
+        for (auto& held : held_notes) {
+            if (held.active && time_reached(held.release_at)) {
+                audio_api->noteOff(held.midi_note);
+                held.active = false;
+            }
+        }
+    }
 
 public:
     SimpleMIDISynth() {
-        auto audio_core = std::make_unique<PicoAudioCore>();
+        // 整个渲染循环运行在core1上，主循环的串口与按键处理不再导致断音
+        PicoI2SConfig i2s_config;
+        i2s_config.refill_mode = AudioRefillMode::CORE1;
+        auto audio_core = std::make_unique<PicoAudioCore>(i2s_config);
         audio_api = std::make_unique<AudioAPI>(std::move(audio_core));
     }
 
@@ -85,6 +132,8 @@ public:
         config.channels = 2;           // 保持立体声
         config.bit_depth = 16;         // 16位音频
         config.buffer_size = 512;      // 较小的缓冲区
+        config.buffer_count = 4;       // 队列深度上限
+        config.adaptive_latency = true; // 从浅队列开始，出现欠载时自动加深
         
         if (!audio_api->initialize(config)) {
             printf("❌ 音频系统初始化失败\n");
@@ -96,15 +145,13 @@ public:
         audio_api->setVolume(70);
         audio_api->setWaveType(current_wave);
         
-        // 设置简单的事件回调
-        audio_api->setEventCallback([](const AudioEventData& event) {
-            if (event.event == AudioEvent::PLAYBACK_STARTED) {
-                printf("🎵 %s\n", event.message.c_str());
-            } else if (event.event == AudioEvent::ERROR_OCCURRED) {
-                printf("❌ %s\n", event.message.c_str());
-            }
-        });
-        
+        // MIDI消息由渲染端在块边界处直接取出，不经过主循环
+        audio_api->attachMidiInput(uart_midi);
+        audio_api->attachMidiInput(usb_midi);
+        if (midi_uart.begin(uart_midi)) {
+            printf("🎹 MIDI输入: UART1 RX=GP5 (31250 bps)\n");
+        }
+
         printf("✅ 音频系统初始化成功（22kHz立体声）\n");
         return true;
     }
@@ -123,6 +170,8 @@ public:
         printf("  O         : 切换八度 (3/4/5)\n");
         printf("  D         : 播放当前八度的DO RE MI音阶\n");
         printf("  S         : 停止当前播放\n");
+        printf("  I         : 显示渲染统计 (耗时分布/CPU负载)\n");
+        printf("  X         : USB串口切换为MIDI字节流 (发送0xFF返回按键模式)\n");
         printf("  H/?       : 显示帮助\n");
         printf("  Q         : 退出程序\n");
         printf("\n🎼 当前状态:\n");
@@ -131,6 +180,15 @@ public:
                audio_api->getVolume(),
                current_wave == WaveType::PIANO ? "钢琴音色" : "正弦波",
                audio_api->isMuted() ? "是" : "否");
+        printf("  缓冲欠载: %lu 次  输出延迟: %lu us\n",
+               static_cast<unsigned long>(audio_api->getUnderrunCount()),
+               static_cast<unsigned long>(audio_api->getOutputLatencyUs()));
+        printf("  按键延迟: 最近 %lu us / 最大 %lu us\n",
+               static_cast<unsigned long>(audio_api->getNoteLatencyUs()),
+               static_cast<unsigned long>(audio_api->getMaxNoteLatencyUs()));
+        printf("  MIDI丢弃: UART %lu / USB %lu\n",
+               static_cast<unsigned long>(uart_midi.droppedCount()),
+               static_cast<unsigned long>(usb_midi.droppedCount()));
         printf("  组合键状态: %s\n", 
                shift_pressed ? "低音模式激活" : 
                alt_pressed ? "高音模式激活" : "标准模式");
@@ -142,22 +200,47 @@ public:
             octave = current_octave;
         }
         
-        if (note_frequencies.find(octave) == note_frequencies.end() ||
-            note_frequencies[octave].find(note_num) == note_frequencies[octave].end()) {
+        if (!isValidNote(note_num, octave)) {
             printf("❌ 无效的音符: %d (八度: %d)\n", note_num, octave);
             return;
         }
         
-        float frequency = note_frequencies[octave][note_num];
-        std::string note_name = note_names[octave][note_num];
+        std::string note_name = noteName(note_num, octave);
         
-        // 停止当前播放（避免重叠）
-        if (audio_api->isPlaying()) {
-            audio_api->stop();
+        // 在运行中的音频流里直接触发声部，不重启I2S
+        uint8_t midi_note = midiNoteFor(note_num, octave);
+        if (audio_api->noteOn(midi_note)) {
+            holdNote(midi_note);
+            printf("%s\n", note_name.c_str());
         }
-        
-        // 播放新音符
-        audio_api->playNote(frequency, 400, note_name);
+    }
+
+    void printStats() {
+        AudioStats stats;
+        if (!audio_api->getStats(stats)) {
+            printf("⚠️ 渲染统计未启用 (AUDIO_ENABLE_STATS=0)\n");
+            return;
+        }
+        printf("\n📊 === 渲染统计 === 📊\n");
+        printf("  已渲染缓冲: %lu  取缓冲未命中: %lu  欠载: %lu\n",
+               static_cast<unsigned long>(stats.buffers_rendered),
+               static_cast<unsigned long>(stats.take_misses),
+               static_cast<unsigned long>(stats.underruns));
+        printf("  块周期: %lu us  渲染耗时: 最近 %lu us / 最大 %lu us\n",
+               static_cast<unsigned long>(stats.block_period_us),
+               static_cast<unsigned long>(stats.render_us_last),
+               static_cast<unsigned long>(stats.render_us_max));
+        printf("  CPU负载: 平均 %u.%u%%  峰值 %u.%u%%\n",
+               stats.load_avg_permille / 10, stats.load_avg_permille % 10,
+               stats.load_peak_permille / 10, stats.load_peak_permille % 10);
+        printf("  耗时分布 (占块周期):\n");
+        for (size_t i = 0; i < AudioStats::HISTOGRAM_BINS; ++i) {
+            unsigned lo = static_cast<unsigned>(i * 1000 / AudioStats::HISTOGRAM_BINS);
+            printf("    %3u.%u%%%s : %lu\n", lo / 10, lo % 10,
+                   i + 1 == AudioStats::HISTOGRAM_BINS ? "+" : " ",
+                   static_cast<unsigned long>(stats.render_histogram[i]));
+        }
+        printf("==================\n\n");
     }
 
     void handleVolumeChange(int delta) {
@@ -195,21 +278,39 @@ public:
         // 创建当前八度的音阶序列
         MusicSequence scale_sequence;
         for (int i = 1; i <= 7; i++) {
-            if (note_frequencies[current_octave].find(i) != note_frequencies[current_octave].end()) {
-                scale_sequence.push_back({
-                    note_frequencies[current_octave][i],
-                    350,  // 持续时间
-                    50,   // 暂停时间
-                    1.0f, // 音量
-                    note_names[current_octave][i]
-                });
-            }
+            scale_sequence.push_back({
+                Notes::frequency(midiNoteFor(i, current_octave)),
+                350,  // 持续时间
+                50,   // 暂停时间
+                1.0f, // 音量
+                noteName(i, current_octave)
+            });
         }
         
         audio_api->playSequence(scale_sequence, false);
     }
 
+    /**
+     * @brief USB MIDI模式：把串口收到的全部字节送入MIDI解析器
+     */
+    void processUsbMidi() {
+        int ch;
+        while ((ch = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+            if (ch == 0xFF) {
+                usb_midi_mode = false;
+                printf("⌨️ 已返回按键模式\n");
+                return;
+            }
+            usb_midi.receive(static_cast<uint8_t>(ch), time_us_32());
+        }
+    }
+
     void processInput() {
+        if (usb_midi_mode) {
+            processUsbMidi();
+            return;
+        }
+
         int ch = getchar_timeout_us(0); // 非阻塞读取
         if (ch == PICO_ERROR_TIMEOUT) {
             return;
@@ -278,8 +379,16 @@ public:
                     break;
                 case 's':
                     audio_api->stop();
+                    held_notes.fill(HeldNote{});
                     printf("⏹️ 停止播放\n");
                     break;
+                case 'i':
+                    printStats();
+                    break;
+                case 'x':
+                    usb_midi_mode = true;
+                    printf("🎹 USB串口已切换为MIDI字节流，发送0xFF返回按键模式\n");
+                    break;
                 case 'h':
                 case '?':
                     printHelp();
@@ -299,6 +408,25 @@ public:
         }
     }
 
+    /**
+     * @brief 取出并打印音频事件（消息只在这里格式化）
+     */
+    void printEvents() {
+        AudioEventRecord record;
+        while (audio_api->pollEvents(record)) {
+            AudioEvent event = record.event();
+            if (event != AudioEvent::PLAYBACK_STARTED && event != AudioEvent::ERROR_OCCURRED) {
+                continue;
+            }
+            if (record.code == AudioEventCode::SEQUENCE_LOOPED) {
+                continue;
+            }
+            char text[64];
+            formatEvent(record, text, sizeof(text));
+            printf("%s %s\n", event == AudioEvent::ERROR_OCCURRED ? "❌" : "🎵", text);
+        }
+    }
+
     void run() {
         if (!initialize()) {
             return;
@@ -316,9 +444,11 @@ public:
         while (running) {
             // 处理音频系统
             audio_api->process();
+            printEvents();
             
             // 处理键盘输入
             processInput();
+            releaseExpiredNotes();
             
             // 短暂延迟以避免过度占用CPU
             sleep_ms(10);
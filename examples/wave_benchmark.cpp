@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "WaveGenerator.hpp"
+#include "VoicePool.hpp"
+#include "Voice.hpp"
+#include "Pitch.hpp"
+
+using namespace Audio;
+
+/**
+ * @brief 波形生成器性能基准
+ * 对比逐采样虚调用路径、块渲染路径、静态分派的Voice以及浮点与定点实现，输出每采样CPU周期数；
+ * 并测量复音声部池在4/8/16声部满载时的混音开销、多级波表振荡器的开销与启动时生成波表的耗时，
+ * 以及一次音高更新的开销
+ */
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 22050;
+constexpr size_t BLOCK_SIZE = 256;
+constexpr int BLOCK_COUNT = 64;
+
+int16_t block_buffer[BLOCK_SIZE];
+float float_buffer[BLOCK_SIZE];
+int16_t saw_cycle[2048];
+Wavetable saw_table;    // 约16KB，位于RAM
+
+struct BenchCase {
+    WaveType type;
+    const char* name;
+};
+
+constexpr BenchCase BENCH_CASES[] = {
+    {WaveType::SINE, "正弦波"},
+    {WaveType::SQUARE, "方波"},
+    {WaveType::TRIANGLE, "三角波"},
+    {WaveType::SAWTOOTH, "锯齿波"},
+    {WaveType::PIANO, "钢琴音色"},
+    {WaveType::SQUARE_BL, "带限方波"},
+    {WaveType::TRIANGLE_BL, "带限三角波"},
+    {WaveType::SAWTOOTH_BL, "带限锯齿波"},
+};
+
+/**
+ * @brief 创建并配置一个处于Attack/Decay阶段的生成器
+ */
+template<typename SampleType>
+std::unique_ptr<WaveGenerator<SampleType>> configure(std::unique_ptr<WaveGenerator<SampleType>> generator) {
+    ADSREnvelope envelope;
+    envelope.attack_samples = SAMPLE_RATE / 100;     // 10ms
+    envelope.decay_samples = SAMPLE_RATE / 10;       // 100ms
+    envelope.sustain_level = 0.7f;
+    envelope.release_samples = SAMPLE_RATE / 20;     // 50ms
+    generator->setEnvelope(envelope);
+    generator->setSampleRate(SAMPLE_RATE);
+    generator->setFrequency(440.0f);
+    generator->setAmplitude(0.3f);
+    generator->noteOn();
+    return generator;
+}
+
+/**
+ * @brief 通过工厂创建指定波形的生成器
+ */
+template<typename SampleType = int16_t>
+std::unique_ptr<WaveGenerator<SampleType>> makeGenerator(WaveType type) {
+    return configure<SampleType>(WaveFactory<SampleType>::create(type));
+}
+
+/**
+ * @brief 3谐波精简钢琴音色，用于对比谐波数量对渲染开销的影响
+ */
+using LightPianoProfile = HarmonicProfile<32767, 13107, 6554>;
+
+template<typename SampleType = int16_t>
+std::unique_ptr<WaveGenerator<SampleType>> makeLightPiano() {
+    return configure<SampleType>(std::make_unique<PianoWaveGenerator<SampleType, LightPianoProfile>>());
+}
+
+/**
+ * @brief 将耗时换算为每采样周期数
+ */
+float cyclesPerSample(uint64_t elapsed_us) {
+    float cycles_per_us = static_cast<float>(clock_get_hz(clk_sys)) / 1000000.0f;
+    return elapsed_us * cycles_per_us / (BLOCK_SIZE * BLOCK_COUNT);
+}
+
+/**
+ * @brief 测量任意生成器的块渲染耗时
+ */
+template<typename SampleType>
+float benchRender(std::unique_ptr<WaveGenerator<SampleType>> generator, SampleType* buffer) {
+    uint64_t start = time_us_64();
+    for (int b = 0; b < BLOCK_COUNT; ++b) {
+        generator->render(buffer, BLOCK_SIZE);
+    }
+    return cyclesPerSample(time_us_64() - start);
+}
+
+/**
+ * @brief 逐采样路径（改造前）：每采样一次虚调用
+ */
+float benchPerSample(WaveType type) {
+    auto generator = makeGenerator(type);
+    uint64_t start = time_us_64();
+    for (int b = 0; b < BLOCK_COUNT; ++b) {
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            block_buffer[i] = generator->generateSample();
+        }
+    }
+    return cyclesPerSample(time_us_64() - start);
+}
+
+/**
+ * @brief 块渲染路径（改造后）：每块一次虚调用
+ */
+float benchBlock(WaveType type) {
+    return benchRender(makeGenerator(type), block_buffer);
+}
+
+/**
+ * @brief 浮点块渲染路径（软件浮点，用于对比定点实现）
+ */
+float benchFloatBlock(WaveType type) {
+    return benchRender(makeGenerator<float>(type), float_buffer);
+}
+
+/**
+ * @brief 静态分派路径：振荡器与包络在编译期组合，无虚调用
+ */
+template<typename Osc>
+float benchVoice() {
+    ADSREnvelope envelope;
+    envelope.attack_samples = SAMPLE_RATE / 100;
+    envelope.decay_samples = SAMPLE_RATE / 10;
+    envelope.sustain_level = 0.7f;
+    envelope.release_samples = SAMPLE_RATE / 20;
+
+    Voice<Osc> voice;
+    if constexpr (std::is_same_v<Osc, WavetableOscillator>) {
+        voice.oscillator().setTable(&saw_table);
+    }
+    voice.setEnvelope(envelope);
+    voice.setSampleRate(SAMPLE_RATE);
+    voice.setFrequency(440.0f);
+    voice.setAmplitude(0.3f);
+    voice.noteOn();
+
+    uint64_t start = time_us_64();
+    for (int b = 0; b < BLOCK_COUNT; ++b) {
+        voice.render(block_buffer, BLOCK_SIZE);
+    }
+    return cyclesPerSample(time_us_64() - start);
+}
+
+float benchStatic(WaveType type) {
+    switch (type) {
+        case WaveType::SQUARE: return benchVoice<SquareOscillator>();
+        case WaveType::TRIANGLE: return benchVoice<TriangleOscillator>();
+        case WaveType::SAWTOOTH: return benchVoice<SawtoothOscillator>();
+        case WaveType::PIANO: return benchVoice<HarmonicOscillator<>>();
+        case WaveType::SQUARE_BL: return benchVoice<BandLimitedSquareOscillator>();
+        case WaveType::TRIANGLE_BL: return benchVoice<BandLimitedTriangleOscillator>();
+        case WaveType::SAWTOOTH_BL: return benchVoice<BandLimitedSawtoothOscillator>();
+        case WaveType::SINE:
+        default: return benchVoice<SineOscillator>();
+    }
+}
+
+/**
+ * @brief 复音引擎满载渲染耗时（所有声部处于按下状态）
+ * @tparam Voices 声部数
+ */
+template<size_t Voices>
+float benchPolyphony(WaveType type) {
+    ADSREnvelope envelope;
+    envelope.attack_samples = SAMPLE_RATE / 100;
+    envelope.decay_samples = SAMPLE_RATE / 10;
+    envelope.sustain_level = 0.7f;
+    envelope.release_samples = SAMPLE_RATE / 20;
+
+    VoicePool<Voices> pool(type, envelope);
+    pool.setSampleRate(SAMPLE_RATE);
+    pool.setWavetable(&saw_table);
+    for (size_t v = 0; v < Voices; ++v) {
+        pool.noteOn(static_cast<uint32_t>(v), 220.0f + 55.0f * v, 0.3f / Voices);
+    }
+
+    uint64_t start = time_us_64();
+    for (int b = 0; b < BLOCK_COUNT; ++b) {
+        pool.render(block_buffer, BLOCK_SIZE);
+    }
+    return cyclesPerSample(time_us_64() - start);
+}
+
+/**
+ * @brief 由朴素锯齿波周期生成多级波表（启动时一次）
+ * @return 耗时（毫秒）
+ */
+float buildSawTable() {
+    constexpr size_t LENGTH = sizeof(saw_cycle) / sizeof(saw_cycle[0]);
+    for (size_t n = 0; n < LENGTH; ++n) {
+        saw_cycle[n] = static_cast<int16_t>(static_cast<int32_t>(n * 65535 / LENGTH) - 32767);
+    }
+    uint64_t start = time_us_64();
+    buildWavetable(saw_cycle, LENGTH, saw_table);
+    return (time_us_64() - start) / 1000.0f;
+}
+
+constexpr int PITCH_UPDATES = 4096;
+
+/**
+ * @brief 测量一次音高更新（频率→相位步进）的周期数
+ * @tparam UpdateFunc uint32_t(int i)
+ */
+template<typename UpdateFunc>
+float benchPitchUpdate(UpdateFunc update) {
+    uint32_t checksum = 0;
+    uint64_t start = time_us_64();
+    for (int i = 0; i < PITCH_UPDATES; ++i) {
+        checksum += update(i);
+    }
+    uint64_t elapsed = time_us_64() - start;
+    if (checksum == 1) printf(" "); // 防止计算被优化掉
+    return elapsed * (static_cast<float>(clock_get_hz(clk_sys)) / 1000000.0f) / PITCH_UPDATES;
+}
+
+} // namespace
+
+int main() {
+    stdio_init_all();
+    sleep_ms(2000); // 等待串口连接稳定
+
+    printf("\n=== 波形生成器基准 (%lu Hz, 块大小 %u) ===\n",
+           static_cast<unsigned long>(SAMPLE_RATE), static_cast<unsigned>(BLOCK_SIZE));
+    printf("正弦表位置: %s\n", AUDIO_SINE_TABLE_IN_RAM ? "RAM" : "flash");
+    float build_ms = buildSawTable();
+    printf("%-12s %14s %14s %14s %14s %8s\n", "生成器", "逐采样(周期)", "浮点块(周期)", "定点块(周期)",
+           "静态块(周期)", "加速比");
+
+    for (const auto& bench : BENCH_CASES) {
+        float before = benchPerSample(bench.type);
+        float float_block = benchFloatBlock(bench.type);
+        float after = benchBlock(bench.type);
+        float static_block = benchStatic(bench.type);
+        printf("%-12s %14.1f %14.1f %14.1f %14.1f %7.2fx\n", bench.name, before, float_block, after,
+               static_block, before / static_block);
+    }
+
+    float light_float = benchRender(makeLightPiano<float>(), float_buffer);
+    float light_fixed = benchRender(makeLightPiano<int16_t>(), block_buffer);
+    float light_static = benchVoice<HarmonicOscillator<LightPianoProfile>>();
+    printf("%-12s %14s %14.1f %14.1f %14.1f\n", "钢琴(3谐波)", "-", light_float, light_fixed, light_static);
+    // 波表只有静态分派路径（WaveFactory按正弦波创建）
+    printf("%-12s %14s %14s %14s %14.1f\n", "波表", "-", "-", "-", benchVoice<WavetableOscillator>());
+    printf("锯齿波波表生成: %.1f ms（%u级 × %u点）\n", build_ms,
+           static_cast<unsigned>(Wavetable::LEVELS), static_cast<unsigned>(Wavetable::SIZE));
+
+    printf("\n复音引擎（每输出采样周期数 / 每声部周期数）\n");
+    printf("%-12s %16s %16s %16s\n", "生成器", "4声部", "8声部", "16声部");
+    for (const auto& bench : BENCH_CASES) {
+        float poly4 = benchPolyphony<4>(bench.type);
+        float poly8 = benchPolyphony<8>(bench.type);
+        float poly16 = benchPolyphony<16>(bench.type);
+        printf("%-12s %8.1f/%-7.1f %8.1f/%-7.1f %8.1f/%-7.1f\n", bench.name,
+               poly4, poly4 / 4, poly8, poly8 / 8, poly16, poly16 / 16);
+    }
+    float table4 = benchPolyphony<4>(WaveType::WAVETABLE);
+    float table8 = benchPolyphony<8>(WaveType::WAVETABLE);
+    float table16 = benchPolyphony<16>(WaveType::WAVETABLE);
+    printf("%-12s %8.1f/%-7.1f %8.1f/%-7.1f %8.1f/%-7.1f\n", "波表",
+           table4, table4 / 4, table8, table8 / 8, table16, table16 / 16);
+
+    // 音高更新：原double除法、Q16频率乘法、exp2音高管线（颤音/弯音每个控制周期调用）
+    volatile float frequency = 440.0f;
+    volatile uint32_t sample_rate = SAMPLE_RATE;
+    const uint32_t step_scale = Pitch::stepScale(SAMPLE_RATE);
+    float double_divide = benchPitchUpdate([&](int i) {
+        return static_cast<uint32_t>(((frequency + i) * 4294967296.0) / sample_rate);
+    });
+    float q16_multiply = benchPitchUpdate([&](int i) {
+        return Pitch::phaseStep(Pitch::frequencyQ16(frequency + i), step_scale);
+    });
+    float exp2_pitch = benchPitchUpdate([&](int i) {
+        return Pitch::phaseStepFromPitch(Pitch::fromNote(60) + i * 37, step_scale);
+    });
+    printf("\n音高更新（每次周期数）: double除法 %.1f, Q16频率 %.1f, exp2音高 %.1f\n",
+           double_divide, q16_multiply, exp2_pitch);
+
+    printf("=== 基准完成 ===\n");
+    while (true) {
+        sleep_ms(1000);
+    }
+    return 0;
+}
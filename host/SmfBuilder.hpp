@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief 内存中的标准MIDI文件构建器（仅用于主机基准与测试）
+ * 按音轨追加事件，增量时间由调用方给出；可选择使用running status，
+ * 以覆盖解析器的各种输入形式
+ */
+class SmfBuilder {
+public:
+    /**
+     * @param ppq 每四分音符tick数
+     * @param running_status 连续相同状态字节时省略状态字节
+     */
+    explicit SmfBuilder(uint16_t ppq, bool running_status = true)
+        : ppq_(ppq), running_status_(running_status) {}
+
+    /**
+     * @brief 开始新音轨（之后的事件写入该音轨）
+     */
+    void beginTrack() {
+        tracks_.emplace_back();
+        last_status_ = 0;
+    }
+
+    void noteOn(uint32_t delta, uint8_t channel, uint8_t note, uint8_t velocity) {
+        channelEvent(delta, static_cast<uint8_t>(0x90 | channel), note, velocity);
+    }
+
+    void noteOff(uint32_t delta, uint8_t channel, uint8_t note) {
+        // 使用力度为0的Note On，与running status配合时最常见
+        channelEvent(delta, static_cast<uint8_t>(0x90 | channel), note, 0);
+    }
+
+    void controlChange(uint32_t delta, uint8_t channel, uint8_t controller, uint8_t value) {
+        channelEvent(delta, static_cast<uint8_t>(0xB0 | channel), controller, value);
+    }
+
+    void programChange(uint32_t delta, uint8_t channel, uint8_t program) {
+        writeDelta(delta);
+        writeStatus(static_cast<uint8_t>(0xC0 | channel));
+        track().push_back(program);
+    }
+
+    void tempo(uint32_t delta, uint32_t us_per_quarter) {
+        const uint8_t data[] = {
+            static_cast<uint8_t>(us_per_quarter >> 16),
+            static_cast<uint8_t>(us_per_quarter >> 8),
+            static_cast<uint8_t>(us_per_quarter)
+        };
+        meta(delta, 0x51, data, sizeof(data));
+    }
+
+    void trackName(uint32_t delta, const char* name) {
+        size_t length = 0;
+        while (name[length]) ++length;
+        meta(delta, 0x03, reinterpret_cast<const uint8_t*>(name), length);
+    }
+
+    void sysex(uint32_t delta, const uint8_t* data, size_t size) {
+        writeDelta(delta);
+        track().push_back(0xF0);
+        writeVarLen(static_cast<uint32_t>(size));
+        track().insert(track().end(), data, data + size);
+        last_status_ = 0; // SysEx取消running status
+    }
+
+    void endOfTrack(uint32_t delta) {
+        meta(delta, 0x2F, nullptr, 0);
+    }
+
+    /**
+     * @brief 生成文件镜像
+     * @return 单音轨时为type 0，否则为type 1
+     */
+    std::vector<uint8_t> build() const {
+        std::vector<uint8_t> out = {'M', 'T', 'h', 'd', 0, 0, 0, 6};
+        uint16_t format = tracks_.size() > 1 ? 1 : 0;
+        put16(out, format);
+        put16(out, static_cast<uint16_t>(tracks_.size()));
+        put16(out, ppq_);
+        for (const auto& data : tracks_) {
+            out.insert(out.end(), {'M', 'T', 'r', 'k'});
+            put32(out, static_cast<uint32_t>(data.size()));
+            out.insert(out.end(), data.begin(), data.end());
+        }
+        return out;
+    }
+
+private:
+    uint16_t ppq_;
+    bool running_status_;
+    uint8_t last_status_ = 0;
+    std::vector<std::vector<uint8_t>> tracks_;
+
+    std::vector<uint8_t>& track() { return tracks_.back(); }
+
+    void channelEvent(uint32_t delta, uint8_t status, uint8_t data1, uint8_t data2) {
+        writeDelta(delta);
+        writeStatus(status);
+        track().push_back(data1);
+        track().push_back(data2);
+    }
+
+    void meta(uint32_t delta, uint8_t type, const uint8_t* data, size_t size) {
+        writeDelta(delta);
+        track().push_back(0xFF);
+        track().push_back(type);
+        writeVarLen(static_cast<uint32_t>(size));
+        if (size) track().insert(track().end(), data, data + size);
+        last_status_ = 0; // 元事件取消running status
+    }
+
+    void writeStatus(uint8_t status) {
+        if (!running_status_ || status != last_status_) {
+            track().push_back(status);
+        }
+        last_status_ = status;
+    }
+
+    void writeDelta(uint32_t delta) { writeVarLen(delta); }
+
+    void writeVarLen(uint32_t value) {
+        uint8_t bytes[4];
+        size_t count = 0;
+        do {
+            bytes[count++] = value & 0x7F;
+            value >>= 7;
+        } while (value && count < 4);
+        while (count > 1) {
+            track().push_back(static_cast<uint8_t>(bytes[--count] | 0x80));
+        }
+        track().push_back(bytes[0]);
+    }
+
+    static void put16(std::vector<uint8_t>& out, uint16_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static void put32(std::vector<uint8_t>& out, uint32_t value) {
+        put16(out, static_cast<uint16_t>(value >> 16));
+        put16(out, static_cast<uint16_t>(value));
+    }
+};
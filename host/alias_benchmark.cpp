@@ -0,0 +1,168 @@
+#include <cstdio>
+#include <cmath>
+#include <climits>
+#include <chrono>
+#include <complex>
+#include <type_traits>
+#include <vector>
+
+#include "Voice.hpp"
+
+using namespace Audio;
+
+/**
+ * @brief 带限振荡器频谱基准
+ * 在演示配置的22.05kHz下渲染朴素与PolyBLEP/PolyBLAMP波形以及由朴素锯齿波周期生成的多级波表，
+ * 加Blackman-Harris窗做FFT，把落在谐波主瓣之外的能量计为混叠，输出混叠/谐波能量比与每采样耗时。
+ * 任一带限波形的混叠不低于对应朴素波形时返回非零。
+ * 用法：host_alias_benchmark
+ */
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 22050;
+constexpr size_t FFT_SIZE = 16384;
+constexpr size_t MAIN_LOBE_BINS = 6;        // 4项Blackman-Harris主瓣半宽为4个bin，留出余量
+constexpr size_t BLOCK_SIZE = 64;
+constexpr double SECONDS_TIMED = 120.0;     // 每项计时渲染的音频时长
+constexpr float FREQUENCIES[] = {440.0f, 1000.0f, 2500.0f, 5000.0f};
+
+using Clock = std::chrono::steady_clock;
+
+Wavetable saw_table;    // 由朴素锯齿波周期生成
+
+struct AliasResult {
+    double alias_db;            // 混叠能量 / 谐波能量（dB）
+    double ns_per_sample;
+};
+
+/**
+ * @brief 原地基2 FFT
+ */
+void fft(std::vector<std::complex<double>>& data) {
+    const size_t n = data.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    for (size_t length = 2; length <= n; length <<= 1) {
+        double angle = -2.0 * M_PI / length;
+        std::complex<double> root(std::cos(angle), std::sin(angle));
+        for (size_t i = 0; i < n; i += length) {
+            std::complex<double> w(1.0);
+            for (size_t k = 0; k < length / 2; ++k) {
+                std::complex<double> even = data[i + k];
+                std::complex<double> odd = data[i + k + length / 2] * w;
+                data[i + k] = even + odd;
+                data[i + k + length / 2] = even - odd;
+                w *= root;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 按实际相位步进对应的频率统计谐波主瓣内外的能量
+ * @return 混叠/谐波能量比（dB）
+ */
+double aliasRatioDb(const std::vector<int16_t>& pcm, double frequency) {
+    std::vector<std::complex<double>> spectrum(FFT_SIZE);
+    for (size_t i = 0; i < FFT_SIZE; ++i) {
+        double x = 2.0 * M_PI * i / (FFT_SIZE - 1);
+        double window = 0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2 * x) - 0.01168 * std::cos(3 * x);
+        spectrum[i] = pcm[i] * window;
+    }
+    fft(spectrum);
+
+    std::vector<bool> harmonic(FFT_SIZE / 2 + 1, false);
+    for (double f = frequency; f < SAMPLE_RATE / 2.0; f += frequency) {
+        double bin = f * FFT_SIZE / SAMPLE_RATE;
+        size_t low = bin > MAIN_LOBE_BINS ? static_cast<size_t>(bin) - MAIN_LOBE_BINS : 0;
+        size_t high = std::min(static_cast<size_t>(bin) + MAIN_LOBE_BINS + 1, FFT_SIZE / 2);
+        for (size_t k = low; k <= high; ++k) harmonic[k] = true;
+    }
+
+    double signal = 0.0;
+    double alias = 0.0;
+    for (size_t k = MAIN_LOBE_BINS; k <= FFT_SIZE / 2; ++k) {
+        double energy = std::norm(spectrum[k]);
+        (harmonic[k] ? signal : alias) += energy;
+    }
+    return 10.0 * std::log10(alias / signal);
+}
+
+template<typename Osc>
+AliasResult measure(float frequency) {
+    ADSREnvelope envelope;
+    envelope.sustain_level = 1.0f;
+    Voice<Osc> voice;
+    if constexpr (std::is_same_v<Osc, WavetableOscillator>) {
+        voice.oscillator().setTable(&saw_table);
+    }
+    voice.setEnvelope(envelope);
+    voice.setSampleRate(SAMPLE_RATE);
+    voice.setFrequency(frequency);
+    voice.setAmplitude(0.5f);
+    voice.noteOn();
+
+    std::vector<int16_t> pcm(FFT_SIZE);
+    for (size_t i = 0; i < FFT_SIZE; i += BLOCK_SIZE) {
+        voice.render(pcm.data() + i, BLOCK_SIZE);
+    }
+    double actual = Pitch::phaseStep(Pitch::frequencyQ16(frequency), Pitch::stepScale(SAMPLE_RATE))
+                  * static_cast<double>(SAMPLE_RATE) / 4294967296.0;
+    double alias_db = aliasRatioDb(pcm, actual);
+
+    int16_t buffer[BLOCK_SIZE];
+    size_t blocks = static_cast<size_t>(SECONDS_TIMED * SAMPLE_RATE / BLOCK_SIZE);
+    int32_t checksum = 0;
+    auto start = Clock::now();
+    for (size_t b = 0; b < blocks; ++b) {
+        voice.render(buffer, BLOCK_SIZE);
+        checksum += buffer[b % BLOCK_SIZE]; // 防止渲染被优化掉
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    if (checksum == INT32_MIN) std::printf(" ");
+
+    return {alias_db, elapsed * 1e9 / (blocks * BLOCK_SIZE)};
+}
+
+template<typename Naive, typename BandLimited>
+bool compare(const char* name) {
+    bool improved = true;
+    for (float frequency : FREQUENCIES) {
+        AliasResult naive = measure<Naive>(frequency);
+        AliasResult band_limited = measure<BandLimited>(frequency);
+        std::printf("%-10s %8.0f %12.1f %12.1f %12.2f %12.2f\n", name, frequency,
+                    naive.alias_db, band_limited.alias_db, naive.ns_per_sample, band_limited.ns_per_sample);
+        if (band_limited.alias_db >= naive.alias_db) {
+            std::printf("  带限波形的混叠没有降低！\n");
+            improved = false;
+        }
+    }
+    return improved;
+}
+
+} // namespace
+
+int main() {
+    std::vector<int16_t> cycle(2048);
+    for (size_t n = 0; n < cycle.size(); ++n) {
+        cycle[n] = static_cast<int16_t>(static_cast<int32_t>(n * 65535 / cycle.size()) - 32767);
+    }
+    auto build_start = Clock::now();
+    buildWavetable(cycle.data(), cycle.size(), saw_table);
+    double build_ms = std::chrono::duration<double, std::milli>(Clock::now() - build_start).count();
+
+    std::printf("=== 带限振荡器混叠基准 (%u Hz, FFT %zu点) ===\n", SAMPLE_RATE, FFT_SIZE);
+    std::printf("%-10s %8s %12s %12s %12s %12s\n", "波形", "频率", "朴素(dB)", "带限(dB)",
+                "朴素(ns/采样)", "带限(ns/采样)");
+
+    bool improved = compare<SawtoothOscillator, BandLimitedSawtoothOscillator>("锯齿波");
+    improved &= compare<SquareOscillator, BandLimitedSquareOscillator>("方波");
+    improved &= compare<TriangleOscillator, BandLimitedTriangleOscillator>("三角波");
+    improved &= compare<SawtoothOscillator, WavetableOscillator>("波表锯齿");
+    std::printf("锯齿波波表生成耗时 %.2f ms（%zu级 × %zu点）\n", build_ms, Wavetable::LEVELS, Wavetable::SIZE);
+    return improved ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+# ==============================================================================
+# Host build of the audio framework (included from the top-level CMakeLists.txt)
+# PicoAudioCore, GPIO mute and the TFT driver are replaced by OfflineAudioCore,
+# which renders to memory or a WAV file as fast as possible.
+# ==============================================================================
+project(pico_audio_framework_host CXX)
+set(CMAKE_CXX_STANDARD 17)
+set(CMAKE_CXX_STANDARD_REQUIRED ON)
+set(CMAKE_CXX_EXTENSIONS OFF)
+
+if(NOT CMAKE_BUILD_TYPE AND NOT CMAKE_CONFIGURATION_TYPES)
+    set(CMAKE_BUILD_TYPE Release CACHE STRING "Build type" FORCE)
+endif()
+
+set(AUDIO_ROOT ${CMAKE_CURRENT_SOURCE_DIR})
+
+add_library(pico_audio_framework STATIC
+    ${AUDIO_ROOT}/src/AudioAPI.cpp
+    ${AUDIO_ROOT}/src/MusicSequencer.cpp
+    ${AUDIO_ROOT}/src/NoteEvent.cpp
+    ${AUDIO_ROOT}/src/TempoMap.cpp
+    ${AUDIO_ROOT}/src/MidiFile.cpp
+    ${AUDIO_ROOT}/src/MidiPlayer.cpp
+    ${AUDIO_ROOT}/src/MidiInput.cpp
+    ${AUDIO_ROOT}/src/AudioEvent.cpp
+    ${AUDIO_ROOT}/src/SineTable.cpp
+    ${AUDIO_ROOT}/src/Wavetable.cpp
+    ${AUDIO_ROOT}/src/OfflineAudioCore.cpp
+)
+
+target_include_directories(pico_audio_framework PUBLIC
+    ${AUDIO_ROOT}/include
+)
+
+option(AUDIO_ENABLE_STATS "Collect per-block render statistics" ON)
+if(NOT AUDIO_ENABLE_STATS)
+    target_compile_definitions(pico_audio_framework PUBLIC AUDIO_ENABLE_STATS=0)
+endif()
+
+target_compile_features(pico_audio_framework PUBLIC cxx_std_17)
+target_compile_options(pico_audio_framework PUBLIC
+    -Wall
+    -Wextra
+    -Wno-unused-parameter
+)
+
+# ==============================================================================
+# Host Throughput Benchmark
+# ==============================================================================
+add_executable(host_throughput_benchmark
+    ${AUDIO_ROOT}/host/throughput_benchmark.cpp
+)
+target_link_libraries(host_throughput_benchmark PRIVATE pico_audio_framework)
+
+# ==============================================================================
+# Host MIDI File Parse Benchmark
+# ==============================================================================
+add_executable(host_midi_parse_benchmark
+    ${AUDIO_ROOT}/host/midi_parse_benchmark.cpp
+)
+target_include_directories(host_midi_parse_benchmark PRIVATE ${AUDIO_ROOT}/host)
+target_link_libraries(host_midi_parse_benchmark PRIVATE pico_audio_framework)
+
+# ==============================================================================
+# Host Voice Dispatch Benchmark (virtual WaveGenerator vs static Voice<Osc, Env>)
+# ==============================================================================
+add_executable(host_voice_dispatch_benchmark
+    ${AUDIO_ROOT}/host/voice_dispatch_benchmark.cpp
+)
+target_link_libraries(host_voice_dispatch_benchmark PRIVATE pico_audio_framework)
+
+# ==============================================================================
+# Host Alias Benchmark (naive vs PolyBLEP/PolyBLAMP oscillators, FFT alias energy)
+# ==============================================================================
+add_executable(host_alias_benchmark
+    ${AUDIO_ROOT}/host/alias_benchmark.cpp
+)
+target_link_libraries(host_alias_benchmark PRIVATE pico_audio_framework)
+
+# ==============================================================================
+# Golden Audio Regression Test
+# golden_audio_update rewrites tests/golden/golden_audio.txt after an intended
+# output change (only if the tolerance checks still pass).
+# ==============================================================================
+enable_testing()
+
+set(AUDIO_GOLDEN_FILE ${AUDIO_ROOT}/tests/golden/golden_audio.txt)
+
+add_executable(golden_audio_test
+    ${AUDIO_ROOT}/tests/golden_audio_test.cpp
+)
+target_include_directories(golden_audio_test PRIVATE ${AUDIO_ROOT}/host)
+target_link_libraries(golden_audio_test PRIVATE pico_audio_framework)
+
+add_test(NAME golden_audio COMMAND golden_audio_test ${AUDIO_GOLDEN_FILE})
+
+add_custom_target(golden_audio_update
+    COMMAND golden_audio_test ${AUDIO_GOLDEN_FILE} --update
+    DEPENDS golden_audio_test
+    COMMENT "Regenerating golden audio hashes"
+)
+
+message(STATUS "Host build: pico_audio_framework, host_throughput_benchmark, host_midi_parse_benchmark, host_voice_dispatch_benchmark, host_alias_benchmark, golden_audio_test")
@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <chrono>
+#include <vector>
+
+#include "MidiFile.hpp"
+#include "MidiPlayer.hpp"
+#include "SmfBuilder.hpp"
+
+using namespace Audio;
+
+/**
+ * @brief MIDI文件解析基准
+ * 在内存中生成一个多音轨type 1文件（含running status、SysEx、音轨名和速度变化），
+ * 测量合并事件流与带采样位置换算的播放调度每秒可处理的事件数。
+ * 用法：host_midi_parse_benchmark
+ */
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 44100;
+constexpr uint16_t PPQ = 480;
+constexpr size_t TRACKS = 8;
+constexpr size_t NOTES_PER_TRACK = 20000;
+constexpr size_t PASSES = 20;
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+std::vector<uint8_t> buildFile() {
+    SmfBuilder smf(PPQ);
+    uint32_t seed = 12345;
+    auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 16;
+    };
+
+    // 速度轨：每16小节变化一次速度
+    smf.beginTrack();
+    smf.trackName(0, "tempo");
+    uint32_t total_ticks = static_cast<uint32_t>(NOTES_PER_TRACK * PPQ / 2);
+    for (uint32_t tick = 0; tick < total_ticks; tick += PPQ * 64) {
+        smf.tempo(tick == 0 ? 0 : PPQ * 64, 400000 + (random() % 200000));
+    }
+    smf.endOfTrack(0);
+
+    static const uint8_t SYSEX[] = {0x7E, 0x7F, 0x09, 0x01, 0xF7}; // GM System On
+    for (size_t t = 1; t < TRACKS; ++t) {
+        uint8_t channel = static_cast<uint8_t>(t - 1);
+        smf.beginTrack();
+        smf.trackName(0, "part");
+        smf.sysex(0, SYSEX, sizeof(SYSEX));
+        smf.programChange(0, channel, static_cast<uint8_t>(t * 8));
+        for (size_t n = 0; n < NOTES_PER_TRACK; ++n) {
+            uint8_t note = static_cast<uint8_t>(36 + random() % 48);
+            uint32_t gap = (random() % 4) * (PPQ / 8);
+            smf.noteOn(gap, channel, note, static_cast<uint8_t>(40 + random() % 80));
+            if (n % 64 == 0) {
+                smf.controlChange(0, channel, 7, static_cast<uint8_t>(random() % 128));
+            }
+            smf.noteOff(PPQ / 2 - gap, channel, note);
+        }
+        smf.endOfTrack(0);
+    }
+    return smf.build();
+}
+
+} // namespace
+
+int main() {
+    std::vector<uint8_t> image = buildFile();
+
+    MidiFile file;
+    if (!file.open(image.data(), image.size())) {
+        std::printf("MIDI文件解析失败\n");
+        return 1;
+    }
+
+    std::printf("=== MIDI文件解析基准 (%zu 音轨, %zu 字节, %zu 遍) ===\n",
+                file.trackCount(), image.size(), PASSES);
+
+    // 合并事件流：只做字节解析和音轨合并
+    MidiEventStream stream;
+    stream.reset(file);
+    size_t events = 0;
+    uint64_t checksum = 0;
+    auto start = Clock::now();
+    for (size_t pass = 0; pass < PASSES; ++pass) {
+        stream.rewind();
+        MidiEvent event;
+        while (stream.next(event)) {
+            checksum += event.tick + event.data1;
+            ++events;
+        }
+    }
+    double elapsed = secondsSince(start);
+    std::printf("事件流:   %10zu 事件/遍  %8.2f M事件/秒\n", events / PASSES, events / elapsed / 1e6);
+
+    // 播放调度：另外处理速度事件并换算为采样位置
+    MidiPlayer player;
+    player.setFile(file, SAMPLE_RATE);
+    size_t channel_events = 0;
+    start = Clock::now();
+    for (size_t pass = 0; pass < PASSES; ++pass) {
+        player.restart(0);
+        while (player.hasEvent()) {
+            checksum += player.eventSample();
+            ++channel_events;
+            player.next();
+        }
+    }
+    elapsed = secondsSince(start);
+    std::printf("播放调度: %10zu 事件/遍  %8.2f M事件/秒\n", channel_events / PASSES,
+                channel_events / elapsed / 1e6);
+    std::printf("文件时长: %.1f 秒 (@ %u Hz)\n",
+                static_cast<double>(player.eventSample()) / SAMPLE_RATE, SAMPLE_RATE);
+
+    std::printf("内存占用: MidiEventStream %zu 字节, MidiPlayer %zu 字节（与事件数无关）\n",
+                sizeof(MidiEventStream), sizeof(MidiPlayer));
+    if (checksum == 0) std::printf(" "); // 防止解析被优化掉
+    return 0;
+}
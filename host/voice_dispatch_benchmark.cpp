@@ -0,0 +1,155 @@
+#include <cstdio>
+#include <climits>
+#include <chrono>
+#include <memory>
+
+#include "WaveGenerator.hpp"
+#include "Voice.hpp"
+
+using namespace Audio;
+
+/**
+ * @brief 声部分派方式基准
+ * 对比三种单声部定点渲染路径在不同块大小下的吞吐量：
+ *  - 虚函数：WaveFactory创建的WaveGenerator<int16_t>，经基类指针每块一次虚调用
+ *  - 类型擦除：WaveVoice，每块按WaveType分派一次（VoicePool使用的路径）
+ *  - 静态：Voice<Osc>，振荡器与包络在编译期组合
+ * 三条路径的输出必须逐位一致，否则返回非零。
+ * 用法：host_voice_dispatch_benchmark
+ */
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 44100;
+constexpr size_t MAX_BLOCK_SIZE = 256;
+constexpr size_t BLOCK_SIZES[] = {16, 64, 256};
+constexpr double SECONDS_PER_CASE = 600.0;  // 每项计时渲染的音频时长
+constexpr double SECONDS_VERIFIED = 10.0;   // 逐采样校验的音频时长（不计时）
+
+struct BenchCase {
+    WaveType type;
+    const char* name;
+};
+
+constexpr BenchCase BENCH_CASES[] = {
+    {WaveType::SINE, "正弦波"},
+    {WaveType::SQUARE, "方波"},
+    {WaveType::TRIANGLE, "三角波"},
+    {WaveType::SAWTOOTH, "锯齿波"},
+    {WaveType::PIANO, "钢琴音色"},
+};
+
+struct BenchResult {
+    double samples_per_second;
+    uint64_t hash;      // 开头SECONDS_VERIFIED秒输出的FNV-1a，用于校验三条路径一致
+};
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief 配置一个处于Attack/Decay/Sustain阶段的声部
+ */
+template<typename Generator>
+void configure(Generator& generator) {
+    ADSREnvelope envelope;
+    envelope.attack_samples = SAMPLE_RATE / 100;
+    envelope.decay_samples = SAMPLE_RATE / 10;
+    envelope.sustain_level = 0.7f;
+    envelope.release_samples = SAMPLE_RATE / 20;
+    generator.setEnvelope(envelope);
+    generator.setSampleRate(SAMPLE_RATE);
+    generator.setFrequency(440.0f);
+    generator.setAmplitude(0.3f);
+    generator.noteOn();
+}
+
+/**
+ * @brief 按固定块大小渲染：先校验开头的输出，再计时渲染
+ * @tparam RenderFunc void(int16_t* out, size_t count)
+ */
+template<typename RenderFunc>
+BenchResult run(size_t block_size, RenderFunc render) {
+    int16_t buffer[MAX_BLOCK_SIZE];
+    uint64_t hash = 1469598103934665603ull;
+    size_t blocks = static_cast<size_t>(SECONDS_VERIFIED * SAMPLE_RATE / block_size);
+    for (size_t b = 0; b < blocks; ++b) {
+        render(buffer, block_size);
+        for (size_t i = 0; i < block_size; ++i) {
+            hash = (hash ^ static_cast<uint16_t>(buffer[i])) * 1099511628211ull;
+        }
+    }
+
+    blocks = static_cast<size_t>(SECONDS_PER_CASE * SAMPLE_RATE / block_size);
+    int32_t checksum = 0;
+    auto start = Clock::now();
+    for (size_t b = 0; b < blocks; ++b) {
+        render(buffer, block_size);
+        checksum += buffer[b % block_size]; // 防止渲染被优化掉
+    }
+    double elapsed = secondsSince(start);
+
+    if (checksum == INT32_MIN) std::printf(" ");
+    return {blocks * block_size / elapsed, hash};
+}
+
+BenchResult benchVirtual(WaveType type, size_t block_size) {
+    std::unique_ptr<WaveGenerator<int16_t>> generator = WaveFactory<int16_t>::create(type);
+    configure(*generator);
+    return run(block_size, [&](int16_t* out, size_t count) { generator->render(out, count); });
+}
+
+BenchResult benchWaveVoice(WaveType type, size_t block_size) {
+    WaveVoice<> voice(type);
+    configure(voice);
+    return run(block_size, [&](int16_t* out, size_t count) { voice.render(out, count); });
+}
+
+template<typename Osc>
+BenchResult benchVoice(size_t block_size) {
+    Voice<Osc> voice;
+    configure(voice);
+    return run(block_size, [&](int16_t* out, size_t count) { voice.render(out, count); });
+}
+
+BenchResult benchStatic(WaveType type, size_t block_size) {
+    switch (type) {
+        case WaveType::SQUARE: return benchVoice<SquareOscillator>(block_size);
+        case WaveType::TRIANGLE: return benchVoice<TriangleOscillator>(block_size);
+        case WaveType::SAWTOOTH: return benchVoice<SawtoothOscillator>(block_size);
+        case WaveType::PIANO: return benchVoice<HarmonicOscillator<>>(block_size);
+        case WaveType::SINE:
+        default: return benchVoice<SineOscillator>(block_size);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::printf("=== 声部分派基准 (%u Hz, 每项 %.0f 秒音频) ===\n", SAMPLE_RATE, SECONDS_PER_CASE);
+    std::printf("%-12s %6s %14s %14s %14s %8s\n", "生成器", "块大小",
+                "虚函数(M/s)", "类型擦除(M/s)", "静态(M/s)", "加速比");
+
+    bool consistent = true;
+    for (const auto& bench : BENCH_CASES) {
+        for (size_t block_size : BLOCK_SIZES) {
+            BenchResult virtual_path = benchVirtual(bench.type, block_size);
+            BenchResult erased_path = benchWaveVoice(bench.type, block_size);
+            BenchResult static_path = benchStatic(bench.type, block_size);
+            std::printf("%-12s %6zu %14.1f %14.1f %14.1f %7.2fx\n", bench.name, block_size,
+                        virtual_path.samples_per_second / 1e6, erased_path.samples_per_second / 1e6,
+                        static_path.samples_per_second / 1e6,
+                        static_path.samples_per_second / virtual_path.samples_per_second);
+            if (erased_path.hash != virtual_path.hash || static_path.hash != virtual_path.hash) {
+                std::printf("  输出不一致！\n");
+                consistent = false;
+            }
+        }
+    }
+
+    std::printf("内存占用: WaveVoice %zu 字节, Voice<SineOscillator> %zu 字节, 钢琴生成器 %zu 字节\n",
+                sizeof(WaveVoice<>), sizeof(Voice<SineOscillator>), sizeof(PianoWaveGenerator<int16_t>));
+    return consistent ? 0 : 1;
+}
@@ -2,47 +2,74 @@
 
 #include "AudioCore.hpp"
 #include "MusicSequencer.hpp"
-#include "PicoAudioCore.hpp"
 #include "Notes.hpp"
+#include "SPSCQueue.hpp"
+#include "MidiInput.hpp"
+#include "AudioEvent.hpp"
 // WAV功能暂时禁用 - 缺少pico_fatfs依赖
 // #include "WAVPlayer.h"
 #include <memory>
+#include <array>
 #include <string>
-#include <map>
 #include <functional>
+#include <atomic>
 
 namespace Audio {
 
 /**
- * @brief 音频事件类型枚举
- */
-enum class AudioEvent {
-    PLAYBACK_STARTED,
-    PLAYBACK_STOPPED,
-    PLAYBACK_PAUSED,
-    NOTE_CHANGED,
-    VOLUME_CHANGED,
-    ERROR_OCCURRED
-};
-
-/**
- * @brief 音频事件数据结构
+ * @brief 音频事件数据结构（带可读消息，由process()在主循环中生成）
  */
 struct AudioEventData {
     AudioEvent event = AudioEvent::PLAYBACK_STARTED;
     std::string message;
     int32_t value = 0;
     float float_value = 0.0f;
+    AudioEventCode code = AudioEventCode::STOPPED;
+    uint32_t timestamp_us = 0;
     
     AudioEventData() = default;
     AudioEventData(AudioEvent e, const std::string& msg = "", int32_t val = 0, float fval = 0.0f);
+
+    /**
+     * @brief 由事件记录生成（格式化消息）
+     * @param record 事件记录
+     */
+    explicit AudioEventData(const AudioEventRecord& record);
 };
 
 /**
- * @brief 音频事件回调函数类型
+ * @brief 音频事件回调函数类型（在process()中调用）
  */
 using AudioEventCallback = std::function<void(const AudioEventData&)>;
 
+/**
+ * @brief 音频控制命令类型
+ */
+enum class AudioCommandType : uint8_t {
+    STOP,
+    PAUSE,
+    PLAY,           // value为序列代号（用于完成通知）
+    PLAY_INDEX,
+    SET_SEQUENCE,   // 采用暂存区中的序列（value为SequenceSource）
+    SET_LOOP,
+    SET_VOLUME,
+    SET_PAN,        // value为Q15有符号声像
+    SET_WAVE_TYPE,  // value为WaveType
+    SET_WAVETABLE,  // 采用暂存的波表指针
+    SET_TEMPO_MAP,  // 采用暂存区中的速度表
+    NOTE_ON,        // value低8位为MIDI音符号，次8位为力度
+    NOTE_OFF        // value为MIDI音符号
+};
+
+/**
+ * @brief 音频控制命令
+ * 由控制端写入命令队列，渲染端在块边界处应用
+ */
+struct AudioCommand {
+    AudioCommandType type;
+    uint32_t value;
+};
+
 
 
 /**
@@ -86,6 +113,27 @@ public:
      */
     bool playSequence(const MusicSequence& sequence, bool loop = false);
 
+    /**
+     * @brief 零复制播放事件序列
+     * 序列可以是flash中的常量数组（如用makeNoteEvent()构造的constexpr表），
+     * 播放期间数据必须保持有效
+     * @param events 事件序列视图
+     * @param loop 是否循环播放
+     * @return 是否启动成功
+     */
+    bool playSequence(EventSequence events, bool loop = false);
+
+    /**
+     * @brief 播放标准MIDI文件（SMF type 0/1）
+     * 文件在镜像中就地流式解析，不复制、不展开为事件表；镜像可以直接位于flash，
+     * 播放期间必须保持有效。打击乐通道（第10通道）被忽略
+     * @param data 文件镜像
+     * @param size 镜像字节数
+     * @param loop 是否循环播放
+     * @return 文件无法解析或启动失败时返回false
+     */
+    bool playMidiFile(const uint8_t* data, size_t size, bool loop = false);
+
     /**
      * @brief 播放单个音符
      * @param frequency 频率（Hz）
@@ -95,6 +143,46 @@ public:
      */
     bool playNote(float frequency, uint32_t duration = 500, const std::string& note_name = "");
 
+    /**
+     * @brief 在运行中的音频流里触发音符
+     * 不会停止或重启I2S，命令在下一个缓冲边界生效（延迟不超过一个缓冲）
+     * @param note MIDI音符号（0-127）
+     * @param velocity 力度（1-127）
+     * @return 是否成功
+     */
+    bool noteOn(uint8_t note, uint8_t velocity = 100);
+
+    /**
+     * @brief 释放音符（进入Release阶段）
+     * @param note MIDI音符号（0-127）
+     * @return 是否成功
+     */
+    bool noteOff(uint8_t note);
+
+    /**
+     * @brief 接入MIDI输入端口
+     * 渲染端在每个块边界取出端口中的消息并应用（不经过主循环），
+     * 音符按通道区分，第1通道与noteOn()/noteOff()共用音符标识；打击乐通道（第10通道）被忽略；
+     * 支持All Notes Off (CC 123)与All Sound Off (CC 120)。音频流停止时，process()在收到消息后重新启动音频流。
+     * 端口在AudioAPI销毁前必须保持有效，消息时间戳应与AudioCore::getTimestampUs()同一时钟
+     * @param input MIDI输入端口
+     * @return 已接入的端口数达到上限时返回false
+     */
+    bool attachMidiInput(MidiInput& input);
+
+    /**
+     * @brief 获取最近一次测得的按键到DAC延迟
+     * 为noteOn调用到音符被渲染的实测时间，加上输出队列延迟
+     * @return 延迟（微秒），尚未测量时为0
+     */
+    uint32_t getNoteLatencyUs() const;
+
+    /**
+     * @brief 获取测得的最大按键到DAC延迟
+     * @return 延迟（微秒）
+     */
+    uint32_t getMaxNoteLatencyUs() const;
+
     /**
      * @brief 播放指定索引的音符（用于手动控制）
      * @param index 音符索引
@@ -124,12 +212,33 @@ public:
      */
     uint8_t getVolume() const;
 
+    /**
+     * @brief 设置立体声声像
+     * @param pan 声像（-1.0=左，0.0=居中，1.0=右）
+     */
+    void setPan(float pan);
+
     /**
      * @brief 设置波形类型
      * @param wave_type 波形类型
      */
     void setWaveType(WaveType wave_type);
 
+    /**
+     * @brief 设置WAVETABLE波形使用的波表（只传递指针，不复制）
+     * 波表通常由buildWavetable()在初始化时生成，或为离线生成后放在flash中的const对象
+     * @param table 波表（须在播放期间保持有效），nullptr时WAVETABLE按正弦波渲染
+     * @return 未初始化或命令队列已满时返回false
+     */
+    bool setWavetable(const Wavetable* table);
+
+    /**
+     * @brief 设置序列速度表（PPQ与速度变化，默认为1 tick = 1 ms）
+     * @param tempo_map 速度表
+     * @return 上一个速度表尚未生效时返回false
+     */
+    bool setTempoMap(const TempoMap& tempo_map);
+
     /**
      * @brief 获取当前波形类型
      * @return 波形类型
@@ -158,8 +267,35 @@ public:
      */
     void toggleWaveType();
 
+    /**
+     * @brief 获取音频缓冲欠载次数
+     * @return 欠载次数
+     */
+    uint32_t getUnderrunCount() const;
+
+    /**
+     * @brief 获取当前输出延迟
+     * 自适应模式下随队列深度变化
+     * @return 新渲染的音频到达DAC前的排队时间（微秒）
+     */
+    uint32_t getOutputLatencyUs() const;
+
+    /**
+     * @brief 读取渲染统计快照（渲染耗时分布、缓冲未命中、CPU负载）
+     * 只复制一个小结构体，可在主循环中频繁调用
+     * @param stats 输出快照
+     * @return 音频核心不支持或统计未编译（AUDIO_ENABLE_STATS=0）时返回false
+     */
+    bool getStats(AudioStats& stats) const;
+
+    /**
+     * @brief 清零渲染统计
+     */
+    void resetStats();
+
     /**
      * @brief 检查是否正在播放
+     * 状态由渲染端在应用命令和渲染每块后发布；音频流运行时，队列中的PAUSE/STOP在下一个块边界后才反映出来
      * @return 是否正在播放
      */
     bool isPlaying() const;
@@ -170,8 +306,25 @@ public:
      */
     PlaybackState getPlaybackState() const;
 
+    /**
+     * @brief 取出一条事件记录（主循环调用）
+     * 事件以定长记录写入无锁环形队列，控制端与渲染端各一个队列，按时间戳顺序取出；
+     * 产生事件时不格式化消息、不分配内存、不调用用户代码。需要可读消息时用formatEvent()
+     * @param record 输出记录
+     * @return 没有待处理事件时返回false
+     */
+    bool pollEvents(AudioEventRecord& record);
+
+    /**
+     * @brief 事件队列已满而丢弃的事件数
+     * @return 丢弃数
+     */
+    uint32_t getDroppedEventCount() const;
+
     /**
      * @brief 设置事件回调函数
+     * 设置后process()取出全部事件并逐条调用回调（与pollEvents()二选一），
+     * 回调总在主循环中执行，不会在渲染端或产生事件的调用内部执行
      * @param callback 事件回调函数
      */
     void setEventCallback(AudioEventCallback callback);
@@ -181,15 +334,9 @@ public:
      */
     void process();
 
-    /**
-     * @brief 获取支持的预设音符
-     * @return 音符名称到频率的映射
-     */
-    static std::map<std::string, float> getPresetNotes();
-
     /**
      * @brief 通过音符名称播放
-     * @param note_name 音符名称（如"DO", "RE", "C4", "A4"等）
+     * @param note_name 音符名称（如"DO"、"SOL5"、"C#4"、"Bb2"，语法见Notes::parseNoteName）
      * @param duration 持续时间（毫秒）
      * @return 是否启动成功
      */
@@ -219,10 +366,54 @@ private:
     AudioEventCallback event_callback_;
     bool initialized_ = false;
     // bool sd_initialized_ = false;  // 暂时禁用
-    bool loop_enabled_ = false;
     uint8_t current_volume_ = 50;
     WaveType current_wave_type_ = WaveType::PIANO;
 
+    // 控制端→渲染端命令队列（仅在回调异步执行时使用）
+    static constexpr size_t COMMAND_QUEUE_SIZE = 16;
+    SPSCQueue<AudioCommand, COMMAND_QUEUE_SIZE> command_queue_;
+
+    // 暂存区：在控制端分配，渲染端只做交换，旧对象交换回来后由控制端释放
+    // 事件缓冲在两次播放间与音序器交换，容量复用，稳定后不再分配
+    std::vector<NoteEvent> staged_events_;
+    EventSequence staged_view_;
+    MidiFile staged_midi_;
+    std::atomic<bool> staged_sequence_pending_{false};
+    TempoMap staged_tempo_map_;
+    std::atomic<bool> staged_tempo_map_pending_{false};
+    std::atomic<const Wavetable*> staged_wavetable_{nullptr};
+
+    // 事件环：控制端与渲染端各为单生产者，主循环为消费者
+    static constexpr size_t EVENT_QUEUE_SIZE = 16;
+    SPSCQueue<AudioEventRecord, EVENT_QUEUE_SIZE> control_events_;
+    SPSCQueue<AudioEventRecord, EVENT_QUEUE_SIZE> render_events_;
+    uint32_t control_events_dropped_ = 0;
+    std::atomic<uint32_t> render_events_dropped_{0};
+    uint32_t loop_count_seen_ = 0;  // 渲染端已报告的音序器循环次数
+
+    // 序列完成通知：控制端为每次播放分配代号，渲染端在序列完成时发布当前代号，
+    // 主循环只对最新一次播放的完成停止音频流（旧序列的迟到通知被忽略）
+    uint32_t sequence_generation_ = 0;                  // 仅控制端
+    uint32_t finished_generation_seen_ = 0;             // 仅控制端
+    uint32_t render_generation_ = 0;                    // 仅渲染端
+    std::atomic<uint32_t> finished_generation_{0};
+
+    // 播放状态：应用命令或渲染一块后由应用方发布，控制端只读此副本，不读音序器
+    std::atomic<PlaybackState> playback_state_{PlaybackState::STOPPED};
+
+    // 实时音符：音频流由noteOn启动后，序列结束时不再停止I2S
+    bool live_stream_ = false;
+
+    // MIDI输入端口（渲染端在块边界处取出消息）
+    static constexpr size_t MAX_MIDI_INPUTS = 2;
+    std::array<std::atomic<MidiInput*>, MAX_MIDI_INPUTS> midi_inputs_{};
+
+    // 按键到DAC延迟测量（时间戳取低32位，差值在约71分钟内有效）
+    std::atomic<uint32_t> note_on_stamp_us_{0};
+    bool note_latency_pending_ = false;
+    std::atomic<uint32_t> note_latency_us_{0};
+    std::atomic<uint32_t> note_latency_max_us_{0};
+
     /**
      * @brief 设置音序器
      */
@@ -234,27 +425,91 @@ private:
      */
     bool checkInitialized();
 
+    /**
+     * @brief 准备暂存序列：检查暂存区是否空闲并停止当前播放
+     * @return 可以写入暂存区时返回true
+     */
+    bool beginSequenceStaging();
+
+    /**
+     * @brief 暂存序列的来源（SET_SEQUENCE命令的value）
+     */
+    enum SequenceSource : uint32_t {
+        STAGED_EVENTS = 0,  // 与staged_events_交换
+        STAGED_VIEW = 1,    // 播放staged_view_
+        STAGED_MIDI = 2     // 播放staged_midi_
+    };
+
+    /**
+     * @brief 提交暂存序列并开始播放
+     * @param source 暂存序列的来源
+     * @param loop 是否循环播放
+     * @return 是否启动成功
+     */
+    bool commitStagedSequence(SequenceSource source, bool loop);
+
     /**
      * @brief 生成音频采样数据
-     * @param samples 采样缓冲区
-     * @param count 采样数量
+     * @param samples 交错采样缓冲区
+     * @param frame_count 帧数
+     * @param layout 声道布局
+     */
+    void generateAudioSamples(int16_t* samples, size_t frame_count, ChannelLayout layout);
+
+    /**
+     * @brief 确保音频流正在运行（已运行时不做任何操作）
+     * @return 是否运行中
+     */
+    bool ensureStreamRunning();
+
+    /**
+     * @brief 记录按键到DAC延迟（渲染端在块开始时调用）
+     */
+    void recordNoteLatency();
+
+    /**
+     * @brief 分发控制命令
+     * 回调异步执行且音频流运行时写入命令队列；否则先应用队列中剩余的命令，再在回调互斥区内直接应用
+     * @param command 控制命令
+     * @return 队列已满时返回false
+     */
+    bool dispatchCommand(const AudioCommand& command);
+
+    /**
+     * @brief 应用控制命令（在渲染端的块边界处调用）
+     * @param command 控制命令
      */
-    void generateAudioSamples(int16_t* samples, size_t count);
+    void applyCommand(const AudioCommand& command);
 
     /**
-     * @brief 发送事件通知
-     * @param event 事件类型
-     * @param message 事件消息
+     * @brief 取出并应用各MIDI输入端口中的消息（在渲染端的块边界处调用）
+     */
+    void pollMidiInputs();
+
+    /**
+     * @brief 应用一条MIDI通道消息
+     * @param message MIDI消息
+     */
+    void applyMidiMessage(const MidiMessage& message);
+
+    /**
+     * @brief 记录控制端事件（写入控制端事件环）
+     * @param code 事件代码
      * @param value 事件值
      */
-    void notifyEvent(AudioEvent event, const std::string& message = "", int32_t value = 0);
+    void notifyEvent(AudioEventCode code, int32_t value = 0);
 
     /**
-     * @brief 波形类型转字符串
-     * @param wave_type 波形类型
-     * @return 波形类型字符串
+     * @brief 记录渲染端事件（写入渲染端事件环，不分配内存）
+     * @param code 事件代码
+     * @param value 事件值
+     */
+    void notifyRenderEvent(AudioEventCode code, int32_t value = 0);
+
+    /**
+     * @brief 生成事件记录（时间戳取自音频核心）
      */
-    std::string waveTypeToString(WaveType wave_type) const;
+    AudioEventRecord makeEventRecord(AudioEventCode code, int32_t value) const;
 };
 
 } // namespace Audio 
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <memory>
 #include <functional>
 #include <vector>
+#include "AudioStats.hpp"
 
 namespace Audio {
 
@@ -15,14 +16,34 @@ struct AudioConfig {
     uint16_t bit_depth = 16;
     uint8_t channels = 2;
     uint32_t buffer_size = 1156;
+    uint8_t buffer_count = 3;         // 缓冲池中的缓冲数量（自适应模式下为队列深度上限）
+    bool adaptive_latency = false;    // 自适应队列深度：欠载时加深，余量充足时变浅
 };
 
+/**
+ * @brief 声道布局（枚举值即每帧声道数）
+ */
+enum class ChannelLayout : uint8_t {
+    MONO = 1,
+    STEREO = 2
+};
+
+/**
+ * @brief 获取声道布局对应的每帧声道数
+ * @param layout 声道布局
+ * @return 声道数
+ */
+constexpr size_t channelCount(ChannelLayout layout) {
+    return static_cast<size_t>(layout);
+}
+
 /**
  * @brief 音频回调函数类型
- * @param samples 采样数据指针
- * @param sample_count 采样数量
+ * @param samples 交错采样数据指针（frame_count * 声道数个采样）
+ * @param frame_count 帧数（每帧包含所有声道各一个采样）
+ * @param layout 声道布局
  */
-using AudioCallback = std::function<void(int16_t* samples, size_t sample_count)>;
+using AudioCallback = std::function<void(int16_t* samples, size_t frame_count, ChannelLayout layout)>;
 
 /**
  * @brief 音频核心抽象基类
@@ -53,6 +74,7 @@ public:
 
     /**
      * @brief 停止音频输出
+     * 返回后回调不再执行（异步回调也已结束），调用方可以直接修改回调所用状态
      */
     virtual void stop() = 0;
 
@@ -80,6 +102,72 @@ public:
      */
     virtual const AudioConfig& getConfig() const = 0;
 
+    /**
+     * @brief 设置静音状态
+     * @param muted 是否静音
+     */
+    virtual void setMuted(bool muted) { (void)muted; }
+
+    /**
+     * @brief 获取静音状态
+     * @return 是否静音
+     */
+    virtual bool isMuted() const { return false; }
+
+    /**
+     * @brief 主循环处理（轮询式实现在此填充缓冲，默认无操作）
+     */
+    virtual void process() {}
+
+    /**
+     * @brief 获取缓冲欠载（underrun）次数
+     * @return 自启动以来检测到的欠载次数
+     */
+    virtual uint32_t getUnderrunCount() const { return 0; }
+
+    /**
+     * @brief 获取输出队列延迟
+     * 刚渲染完成的缓冲需要等待多久才会到达DAC
+     * @return 延迟（微秒）
+     */
+    virtual uint32_t getOutputLatencyUs() const { return 0; }
+
+    /**
+     * @brief 读取渲染统计快照
+     * @param stats 输出快照
+     * @return 实现不支持或统计未编译时返回false
+     */
+    virtual bool getStats(AudioStats& stats) const { (void)stats; return false; }
+
+    /**
+     * @brief 清零渲染统计
+     */
+    virtual void resetStats() {}
+
+    /**
+     * @brief 获取单调时间戳（用于延迟测量）
+     * @return 时间戳（微秒）
+     */
+    virtual uint64_t getTimestampUs() const { return 0; }
+
+    /**
+     * @brief 回调是否在另一个核心上异步执行
+     * 为true时，音频流运行期间调用方不能直接修改回调所用状态，需通过命令队列传递
+     * @return 是否异步执行
+     */
+    virtual bool isCallbackAsync() const { return false; }
+
+    /**
+     * @brief 进入回调互斥区
+     * 当回调在中断中执行时，修改回调所用状态前必须调用
+     */
+    virtual void lockCallback() {}
+
+    /**
+     * @brief 离开回调互斥区
+     */
+    virtual void unlockCallback() {}
+
 protected:
     AudioConfig config_;
     AudioCallback audio_callback_;
@@ -87,4 +175,22 @@ protected:
     bool running_ = false;
 };
 
+/**
+ * @brief 回调互斥区RAII守卫
+ */
+class AudioCallbackLock {
+public:
+    explicit AudioCallbackLock(AudioCore* core) : core_(core) {
+        if (core_) core_->lockCallback();
+    }
+    ~AudioCallbackLock() {
+        if (core_) core_->unlockCallback();
+    }
+    AudioCallbackLock(const AudioCallbackLock&) = delete;
+    AudioCallbackLock& operator=(const AudioCallbackLock&) = delete;
+
+private:
+    AudioCore* core_;
+};
+
 } // namespace Audio 
\ No newline at end of file
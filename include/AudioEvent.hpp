@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Audio {
+
+enum class WaveType;
+
+/**
+ * @brief 音频事件类型枚举
+ */
+enum class AudioEvent : uint8_t {
+    PLAYBACK_STARTED,
+    PLAYBACK_STOPPED,
+    PLAYBACK_PAUSED,
+    NOTE_CHANGED,
+    VOLUME_CHANGED,
+    ERROR_OCCURRED
+};
+
+/**
+ * @brief 音频事件代码（具体原因，决定事件类型与可读消息）
+ */
+enum class AudioEventCode : uint8_t {
+    CORE_MISSING,           // 音频核心未设置
+    CORE_INIT_FAILED,       // 音频核心初始化失败
+    NOT_INITIALIZED,        // 音频系统未初始化
+    SEQUENCER_BUSY,         // 上一个序列或速度表尚未被渲染端取走
+    STREAM_START_FAILED,    // 音频输出启动失败
+    COMMAND_QUEUE_FULL,     // 命令队列已满
+    MIDI_FILE_INVALID,      // MIDI文件无法解析
+    MIDI_INPUT_LIMIT,       // MIDI输入端口数已达上限
+    UNKNOWN_NOTE_NAME,      // 未知音符名称
+    SEQUENCE_STARTED,       // 开始播放序列
+    SEQUENCE_LOOPED,        // 循环序列回到开头（渲染端产生，value为本块内的循环次数）
+    SEQUENCE_FINISHED,      // 序列播放完成
+    STOPPED,                // 播放已停止
+    PAUSED,                 // 播放已暂停
+    NOTE_INDEX,             // 播放指定索引的音符（value为索引）
+    WAVE_TYPE_CHANGED,      // 波形已切换（value为WaveType）
+    VOLUME_CHANGED,         // 音量已设置（value为音量0-100）
+    MUTED,                  // 静音已开启
+    UNMUTED                 // 静音已关闭（value为当前音量）
+};
+
+/**
+ * @brief 定长事件记录（可平凡复制，可在渲染端写入无锁队列）
+ * 只保存代码、数值与时间戳，可读消息由formatEvent()按需生成
+ */
+struct AudioEventRecord {
+    uint32_t timestamp_us = 0;  // AudioCore::getTimestampUs()的低32位
+    int32_t value = 0;          // 事件数值（含义见AudioEventCode）
+    AudioEventCode code = AudioEventCode::STOPPED;
+
+    /**
+     * @brief 事件类型
+     * @return 由事件代码决定的类型
+     */
+    AudioEvent event() const;
+};
+
+/**
+ * @brief 波形类型名称
+ * @param wave_type 波形类型
+ * @return 静态字符串
+ */
+const char* waveTypeName(WaveType wave_type);
+
+/**
+ * @brief 生成事件的可读消息（不分配内存）
+ * @param record 事件记录
+ * @param buffer 输出缓冲区（总是以'\0'结尾）
+ * @param size 缓冲区字节数
+ * @return 完整消息的长度（不含'\0'），大于等于size时消息被截断
+ */
+size_t formatEvent(const AudioEventRecord& record, char* buffer, size_t size);
+
+} // namespace Audio
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+
+/**
+ * @brief 是否编译音频统计
+ * 关闭后渲染路径中不含任何统计代码，getStats()返回false
+ */
+#ifndef AUDIO_ENABLE_STATS
+#define AUDIO_ENABLE_STATS 1
+#endif
+
+namespace Audio {
+
+/**
+ * @brief 音频渲染统计快照
+ * 负载以千分比表示：单块渲染耗时 / 块周期
+ */
+struct AudioStats {
+    static constexpr size_t HISTOGRAM_BINS = 8;   // 每桶为块周期的1/8，最后一桶包含超时
+
+    uint32_t buffers_rendered = 0;                // 已渲染缓冲数
+    uint32_t take_misses = 0;                     // take_audio_buffer未取到缓冲的次数
+    uint32_t underruns = 0;                       // 欠载次数
+    uint32_t block_period_us = 0;                 // 块周期（微秒）
+    uint32_t render_us_last = 0;                  // 最近一块的渲染耗时（微秒）
+    uint32_t render_us_max = 0;                   // 最大渲染耗时（微秒）
+    uint16_t load_peak_permille = 0;              // 峰值负载（‰）
+    uint16_t load_avg_permille = 0;               // 平均负载（‰，指数滑动平均）
+    uint32_t render_histogram[HISTOGRAM_BINS] = {}; // 渲染耗时分布（按块周期比例分桶）
+};
+
+/**
+ * @brief 音频渲染统计采集器
+ * 渲染端（中断或core1）写入，控制端通过snapshot()读取一致的快照；
+ * 写入端用序号标记更新过程，读取端在序号变化时重试，双方都不加锁
+ */
+class AudioStatsCollector {
+public:
+    /**
+     * @brief 设置块周期（初始化时调用）
+     * @param period_us 块周期（微秒）
+     */
+    void setBlockPeriod(uint32_t period_us) {
+        beginWrite();
+        stats_.block_period_us = period_us;
+        endWrite();
+    }
+
+    /**
+     * @brief 记录一个缓冲的渲染耗时（渲染端调用）
+     * @param render_us 渲染耗时（微秒）
+     */
+    void recordBlock(uint32_t render_us) {
+        beginWrite();
+        uint32_t period = stats_.block_period_us ? stats_.block_period_us : 1;
+        uint32_t load = render_us * 1000 / period;
+        if (load > UINT16_MAX) load = UINT16_MAX;
+
+        stats_.buffers_rendered++;
+        stats_.render_us_last = render_us;
+        if (render_us > stats_.render_us_max) stats_.render_us_max = render_us;
+        if (load > stats_.load_peak_permille) stats_.load_peak_permille = static_cast<uint16_t>(load);
+
+        // 平均负载：alpha = 1/16 的指数滑动平均
+        load_avg_acc_ += load - (load_avg_acc_ >> 4);
+        stats_.load_avg_permille = static_cast<uint16_t>(load_avg_acc_ >> 4);
+
+        size_t bin = load * AudioStats::HISTOGRAM_BINS / 1000;
+        if (bin >= AudioStats::HISTOGRAM_BINS) bin = AudioStats::HISTOGRAM_BINS - 1;
+        stats_.render_histogram[bin]++;
+        endWrite();
+    }
+
+    /**
+     * @brief 记录一次take_audio_buffer未取到缓冲（渲染端调用）
+     */
+    void recordTakeMiss() {
+        beginWrite();
+        stats_.take_misses++;
+        endWrite();
+    }
+
+    /**
+     * @brief 记录一次欠载（渲染端调用）
+     */
+    void recordUnderrun() {
+        beginWrite();
+        stats_.underruns++;
+        endWrite();
+    }
+
+    /**
+     * @brief 读取统计快照（控制端调用）
+     * @param stats 输出快照
+     */
+    void snapshot(AudioStats& stats) const {
+        uint32_t before;
+        do {
+            before = sequence_.load(std::memory_order_acquire);
+            stats = stats_;
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((before & 1) || before != sequence_.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief 请求清零统计（在渲染端下一次写入时生效，块周期保留）
+     */
+    void requestReset() {
+        reset_requested_.store(true, std::memory_order_release);
+    }
+
+private:
+    AudioStats stats_;
+    uint32_t load_avg_acc_ = 0;
+    std::atomic<uint32_t> sequence_{0};
+    std::atomic<bool> reset_requested_{false};
+
+    void beginWrite() {
+        sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        if (reset_requested_.load(std::memory_order_acquire)) {
+            reset_requested_.store(false, std::memory_order_relaxed);
+            uint32_t period = stats_.block_period_us;
+            stats_ = AudioStats{};
+            stats_.block_period_us = period;
+            load_avg_acc_ = 0;
+        }
+    }
+
+    void endWrite() {
+        sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+} // namespace Audio
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include "FixedPoint.hpp"
+
+namespace Audio {
+
+/**
+ * @brief ADSR包络参数
+ */
+struct ADSREnvelope {
+    uint32_t attack_samples = 0;   // 攻击时间（采样数）
+    uint32_t decay_samples = 0;    // 衰减时间（采样数）
+    float sustain_level = 1.0f;    // 持续电平（0.0-1.0）
+    uint32_t release_samples = 0;  // 释放时间（采样数）
+};
+
+/**
+ * @brief 线性ADSR包络策略（Q8.24定点）
+ * 各阶段均为线性段，渲染时每段只计算一次起点与斜率。
+ * WaveGenerator的定点路径与VoiceCore都持有此对象，不另行实现包络
+ */
+class LinearEnvelope {
+public:
+    /**
+     * @brief 定点包络线性段（Q24，16777216=1.0）
+     */
+    struct Segment {
+        int32_t level;      // 段起点电平
+        int32_t step;       // 每采样电平增量
+        uint32_t length;    // 段内剩余采样数（UINT32_MAX表示直到下次状态变化）
+    };
+
+    /**
+     * @brief 设置ADSR包络
+     * @param envelope ADSR包络参数
+     */
+    void setEnvelope(const ADSREnvelope& envelope) {
+        envelope_ = envelope;
+        float sustain = std::max(0.0f, std::min(1.0f, envelope.sustain_level));
+        sustain_level_q24_ = static_cast<int32_t>(sustain * FixedPoint::Q24_ONE);
+    }
+
+    void noteOn() {
+        position_ = 0;
+        note_on_ = true;
+    }
+
+    void noteOff() {
+        note_on_ = false;
+        release_start_ = position_;
+    }
+
+    /**
+     * @brief 回到包络起点（不改变按下状态）
+     */
+    void reset() { position_ = 0; }
+
+    bool isNoteOn() const { return note_on_; }
+
+    /**
+     * @brief 是否仍在发声（按下中或Release尚未结束）
+     */
+    bool isActive() const {
+        if (note_on_) return true;
+        return position_ != 0 && position_ - release_start_ < envelope_.release_samples;
+    }
+
+    /**
+     * @brief 包络位置（采样），控制率状态以它为网格
+     */
+    uint32_t position() const { return position_; }
+
+    /**
+     * @brief 松开时的包络位置（Release阶段的起点）
+     */
+    uint32_t releaseStart() const { return release_start_; }
+
+    /**
+     * @brief ADSR包络参数
+     */
+    const ADSREnvelope& parameters() const { return envelope_; }
+
+    /**
+     * @brief 当前包络电平（Q24）
+     */
+    int32_t levelQ24() const { return segment().level; }
+
+    /**
+     * @brief 获取当前包络位置所在的线性段（只使用整数运算）
+     * @return 定点包络线性段
+     */
+    Segment segment() const {
+        constexpr uint32_t UNBOUNDED = UINT32_MAX;
+        constexpr int32_t ONE = FixedPoint::Q24_ONE;
+        uint32_t pos = position_;
+
+        if (!note_on_ && pos == 0) {
+            return {0, 0, UNBOUNDED}; // 音符未开始
+        }
+
+        if (note_on_) {
+            uint32_t attack_end = envelope_.attack_samples;
+            uint32_t decay_end = attack_end + envelope_.decay_samples;
+            if (pos < attack_end) {
+                int32_t step = ONE / static_cast<int32_t>(envelope_.attack_samples);
+                return {static_cast<int32_t>(pos) * step, step, attack_end - pos};
+            } else if (pos < decay_end) {
+                // step * decay_samples <= 1.0，乘积不会溢出
+                int32_t step = -(ONE - sustain_level_q24_) / static_cast<int32_t>(envelope_.decay_samples);
+                return {ONE + static_cast<int32_t>(pos - attack_end) * step, step, decay_end - pos};
+            }
+            return {sustain_level_q24_, 0, UNBOUNDED};
+        }
+
+        uint32_t release_pos = pos - release_start_;
+        if (release_pos >= envelope_.release_samples) {
+            return {0, 0, UNBOUNDED};
+        }
+        int32_t step = -sustain_level_q24_ / static_cast<int32_t>(envelope_.release_samples);
+        return {sustain_level_q24_ + static_cast<int32_t>(release_pos) * step, step,
+                envelope_.release_samples - release_pos};
+    }
+
+    /**
+     * @brief 包络位置前进多个采样（Release结束后停止前进）
+     * @param count 采样数
+     */
+    void advance(uint32_t count) {
+        if (note_on_) {
+            position_ += count;
+        } else if (isActive()) {
+            uint32_t remaining = envelope_.release_samples - (position_ - release_start_);
+            position_ += std::min(count, remaining);
+        }
+    }
+
+private:
+    ADSREnvelope envelope_;
+    int32_t sustain_level_q24_ = FixedPoint::Q24_ONE;
+    uint32_t position_ = 0;
+    uint32_t release_start_ = 0;
+    bool note_on_ = false;
+};
+
+} // namespace Audio
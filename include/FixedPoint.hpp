@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Audio {
+
+/**
+ * @brief 定点运算工具（适用于无FPU的Cortex-M0+）
+ * Q15: 32768 = 1.0；Q24: 16777216 = 1.0
+ */
+namespace FixedPoint {
+
+constexpr int32_t Q15_ONE = 1 << 15;
+constexpr int32_t Q24_ONE = 1 << 24;
+
+/**
+ * @brief 饱和到int16范围（与浮点路径一致，对称取 ±32767）
+ * @param value 32位中间值
+ * @return 饱和后的采样值
+ */
+constexpr int16_t saturate16(int32_t value) {
+    return static_cast<int16_t>(value > 32767 ? 32767 : (value < -32767 ? -32767 : value));
+}
+
+/**
+ * @brief Q15乘法
+ * @param a Q15值
+ * @param b Q15值
+ * @return a*b（Q15）
+ */
+constexpr int32_t mulQ15(int32_t a, int32_t b) {
+    return (a * b) >> 15;
+}
+
+/**
+ * @brief 浮点数转换为Q15（仅用于控制参数，不在采样循环中调用）
+ * @param value 浮点值
+ * @return Q15值，饱和到 [-32768, 32768]
+ */
+constexpr int32_t fromFloatQ15(float value) {
+    float scaled = value * 32768.0f;
+    return scaled >= 32768.0f ? Q15_ONE : (scaled <= -32768.0f ? -Q15_ONE : static_cast<int32_t>(scaled));
+}
+
+/**
+ * @brief 输出音量（0-255）转换为Q15增益，255对应1.0（每块计算一次）
+ * @param volume 音量
+ * @param muted 是否静音
+ * @return Q15增益（0..32768）
+ */
+constexpr int32_t volumeGainQ15(uint8_t volume, bool muted) {
+    return muted ? 0 : (volume * Q15_ONE + 127) / 255;
+}
+
+/**
+ * @brief 原地应用输出音量（所有音频核心共用，设备与主机的输出逐位一致）
+ * 满音量不处理，静音或音量0时清零，其余每采样一次整数乘法
+ * @param samples 样本数据
+ * @param count 样本数量
+ * @param volume 音量（0-255）
+ * @param muted 是否静音
+ */
+inline void applyVolume(int16_t* samples, size_t count, uint8_t volume, bool muted) {
+    const int32_t gain = volumeGainQ15(volume, muted);
+    if (gain == Q15_ONE) return;
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = static_cast<int16_t>(mulQ15(samples[i], gain));
+    }
+}
+
+} // namespace FixedPoint
+
+} // namespace Audio
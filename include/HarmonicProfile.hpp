@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace Audio {
+
+namespace HarmonicDetail {
+
+/**
+ * @brief 编译期平方根（牛顿迭代）
+ */
+constexpr double sqrtNewton(double x) {
+    if (x <= 0.0) return 0.0;
+    double r = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 64; ++i) {
+        r = 0.5 * (r + x / r);
+    }
+    return r;
+}
+
+/**
+ * @brief 编译期计算第h次谐波的衰减 x^(h/2+1)
+ */
+constexpr double harmonicDecay(double x, size_t h) {
+    double result = 1.0;
+    for (size_t i = 0; i < h / 2 + 1; ++i) {
+        result *= x;
+    }
+    return (h % 2) ? result * sqrtNewton(x) : result;
+}
+
+} // namespace HarmonicDetail
+
+/**
+ * @brief 谐波音色配置
+ * 谐波数量与强度均为编译期参数，谐波越少的配置合成循环越短。
+ * 第h次谐波（h=0为基波）的权重为 强度[h] × envelope^(h/2+1)（基波不衰减），
+ * 衰减曲线在编译期预计算为查找表，运行时以控制率线性插值求值，不再逐采样调用pow
+ * @tparam AmplitudesQ15 各次谐波强度（Q15，32767=1.0）
+ */
+template<int16_t... AmplitudesQ15>
+struct HarmonicProfile {
+    static_assert(sizeof...(AmplitudesQ15) > 0, "至少需要一个谐波");
+
+    static constexpr size_t COUNT = sizeof...(AmplitudesQ15);
+    static constexpr size_t CURVE_BITS = 6;
+    static constexpr size_t CURVE_SEGMENTS = size_t(1) << CURVE_BITS;
+    static constexpr size_t CURVE_POINTS = CURVE_SEGMENTS + 1;
+
+    using Curve = std::array<int16_t, CURVE_POINTS>;
+    using Weights = std::array<int32_t, COUNT>;
+
+    static constexpr std::array<int16_t, COUNT> AMPLITUDES = {AmplitudesQ15...};
+
+    /**
+     * @brief 预计算的衰减曲线：CURVES[h][k] = 强度[h] × (k/64)^(h/2+1)（Q15）
+     */
+    static constexpr std::array<Curve, COUNT> CURVES = [] {
+        std::array<Curve, COUNT> curves{};
+        for (size_t h = 0; h < COUNT; ++h) {
+            for (size_t k = 0; k < CURVE_POINTS; ++k) {
+                double x = static_cast<double>(k) / CURVE_SEGMENTS;
+                double decay = (h == 0) ? 1.0 : HarmonicDetail::harmonicDecay(x, h);
+                curves[h][k] = static_cast<int16_t>(AMPLITUDES[h] * decay + 0.5);
+            }
+        }
+        return curves;
+    }();
+
+    /**
+     * @brief 计算各谐波权重（控制率调用）
+     * @param envelope_q15 Q15包络值（0..32768）
+     * @param weights 输出权重（Q15）
+     */
+    static void weightsQ15(int32_t envelope_q15, Weights& weights) {
+        int32_t env = envelope_q15 < 0 ? 0 : (envelope_q15 > 32767 ? 32767 : envelope_q15);
+        constexpr int32_t FRAC_BITS = 15 - CURVE_BITS;
+        int32_t index = env >> FRAC_BITS;
+        int32_t frac = env & ((1 << FRAC_BITS) - 1);
+        for (size_t h = 0; h < COUNT; ++h) {
+            int32_t a = CURVES[h][index];
+            int32_t b = CURVES[h][index + 1];
+            weights[h] = a + (((b - a) * frac) >> FRAC_BITS);
+        }
+    }
+};
+
+/**
+ * @brief 默认钢琴音色：6个谐波，强度 1.0, 0.4, 0.2, 0.1, 0.05, 0.03
+ */
+using DefaultPianoProfile = HarmonicProfile<32767, 13107, 6554, 3277, 1638, 983>;
+
+} // namespace Audio
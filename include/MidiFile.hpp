@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace Audio {
+
+/**
+ * @brief MIDI事件（由SMF解析得到）
+ * 通道消息的status含通道号；元事件的status为0xFF，meta_type为元事件类型
+ */
+struct MidiEvent {
+    uint64_t tick = 0;          // 绝对tick
+    uint8_t status = 0;         // 状态字节（0x80-0xEF为通道消息，0xFF为元事件）
+    uint8_t data1 = 0;          // 第一个数据字节（音符号/控制器号）
+    uint8_t data2 = 0;          // 第二个数据字节（力度/控制器值）
+    uint8_t meta_type = 0;      // 元事件类型（0x51速度，0x2F音轨结束）
+    uint32_t meta_value = 0;    // 元事件数值（速度：每四分音符微秒数）
+    uint8_t track = 0;          // 所属音轨
+
+    static constexpr uint8_t META = 0xFF;
+    static constexpr uint8_t META_TEMPO = 0x51;
+    static constexpr uint8_t META_END_OF_TRACK = 0x2F;
+
+    uint8_t type() const { return status & 0xF0; }
+    uint8_t channel() const { return status & 0x0F; }
+    bool isMeta() const { return status == META; }
+};
+
+/**
+ * @brief 标准MIDI文件（SMF type 0/1）镜像
+ * 只记录文件头和各音轨在镜像中的位置，不复制、不展开事件。
+ * 镜像可以是链接进flash的常量数组或XIP映射的区域，播放期间必须保持有效
+ */
+class MidiFile {
+public:
+    static constexpr size_t MAX_TRACKS = 16;    // 支持的最多音轨数（超出的音轨被忽略）
+
+    /**
+     * @brief 音轨数据在镜像中的位置
+     */
+    struct Track {
+        const uint8_t* data = nullptr;
+        uint32_t size = 0;
+    };
+
+    /**
+     * @brief 解析文件头并定位各音轨
+     * @param data 文件镜像
+     * @param size 镜像字节数
+     * @return 不是SMF、格式为2或使用SMPTE时基时返回false
+     */
+    bool open(const uint8_t* data, size_t size);
+
+    bool isValid() const { return track_count_ > 0; }
+    uint16_t format() const { return format_; }
+    uint16_t ppq() const { return ppq_; }
+    size_t trackCount() const { return track_count_; }
+    const Track& track(size_t index) const { return tracks_[index]; }
+
+private:
+    std::array<Track, MAX_TRACKS> tracks_{};
+    size_t track_count_ = 0;
+    uint16_t format_ = 0;
+    uint16_t ppq_ = 0;
+};
+
+/**
+ * @brief 单条音轨的流式游标
+ * 就地读取音轨字节，处理running status；SysEx与不关心的元事件在读取增量时间时跳过，
+ * 因此nextTick()总是下一个有效事件的tick。数据截断或格式错误时按音轨结束处理
+ */
+class MidiTrackCursor {
+public:
+    /**
+     * @brief 定位到音轨开头
+     * @param track 音轨
+     * @param index 音轨序号（写入事件的track字段）
+     */
+    void reset(const MidiFile::Track& track, uint8_t index);
+
+    bool atEnd() const { return ended_; }
+
+    /**
+     * @brief 下一个有效事件的绝对tick
+     * @return tick
+     */
+    uint64_t nextTick() const { return tick_; }
+
+    /**
+     * @brief 读取下一个有效事件并前进
+     * @param event 输出事件
+     * @return 音轨已结束时返回false
+     */
+    bool read(MidiEvent& event);
+
+private:
+    const uint8_t* pos_ = nullptr;
+    const uint8_t* end_ = nullptr;
+    uint64_t tick_ = 0;
+    uint8_t running_status_ = 0;
+    uint8_t index_ = 0;
+    bool ended_ = true;
+
+    bool readVarLen(uint32_t& value);
+    void seekNextEvent();
+};
+
+/**
+ * @brief 多音轨按时间顺序合并的事件流
+ * 以音轨游标组成小顶堆（按下一个事件的tick，相同tick按音轨序号），
+ * 每取出一个事件只需O(log 音轨数)；内存占用固定，与文件事件数无关
+ */
+class MidiEventStream {
+public:
+    /**
+     * @brief 绑定文件并回到开头
+     * @param file MIDI文件
+     */
+    void reset(const MidiFile& file);
+
+    /**
+     * @brief 回到开头
+     */
+    void rewind();
+
+    /**
+     * @brief 取出下一个事件
+     * @param event 输出事件
+     * @return 所有音轨都已结束时返回false
+     */
+    bool next(MidiEvent& event);
+
+    /**
+     * @brief 已取出事件中最大的tick（全部取完后即文件结束位置）
+     * @return tick
+     */
+    uint64_t lastTick() const { return last_tick_; }
+
+    const MidiFile& file() const { return file_; }
+
+private:
+    MidiFile file_;
+    std::array<MidiTrackCursor, MidiFile::MAX_TRACKS> cursors_{};
+    std::array<uint8_t, MidiFile::MAX_TRACKS> heap_{};
+    size_t heap_size_ = 0;
+    uint64_t last_tick_ = 0;
+
+    bool earlier(uint8_t a, uint8_t b) const;
+    void siftDown(size_t index);
+    void siftUp(size_t index);
+};
+
+} // namespace Audio
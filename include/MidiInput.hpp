@@ -0,0 +1,102 @@
+#pragma once
+
+#include "SPSCQueue.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+
+namespace Audio {
+
+/**
+ * @brief 实时MIDI通道消息（可平凡复制，用于中断→渲染端队列）
+ */
+struct MidiMessage {
+    uint32_t timestamp_us = 0;  // 最后一个字节到达的时间戳（用于测量输入到发声的延迟）
+    uint8_t status = 0;         // 状态字节（含通道号）
+    uint8_t data1 = 0;          // 音符号/控制器号
+    uint8_t data2 = 0;          // 力度/控制器值（单数据字节消息为0）
+
+    uint8_t type() const { return status & 0xF0; }
+    uint8_t channel() const { return status & 0x0F; }
+};
+
+/**
+ * @brief 增量式MIDI 1.0字节流解析器
+ * 每次输入一个字节，组成完整的通道消息时返回true。支持running status；
+ * SysEx整体跳过；系统公共消息被跳过并取消running status；
+ * 实时消息（0xF8-0xFF）可出现在任意位置，被忽略且不打断正在接收的消息
+ */
+class MidiStreamParser {
+public:
+    /**
+     * @brief 输入一个字节
+     * @param byte 接收到的字节
+     * @param message 完整消息（返回true时有效，时间戳由调用方填写）
+     * @return 是否组成了一条完整的通道消息
+     */
+    bool parse(uint8_t byte, MidiMessage& message);
+
+    /**
+     * @brief 清除running status和未完成的消息
+     */
+    void reset();
+
+private:
+    uint8_t running_status_ = 0;
+    uint8_t data_[2] = {};
+    uint8_t data_count_ = 0;
+    uint8_t skip_count_ = 0;        // 系统公共消息剩余的数据字节
+    bool in_sysex_ = false;
+};
+
+/**
+ * @brief MIDI输入端口
+ * 生产者（UART接收中断或USB CDC轮询）逐字节调用receive()，解析出的消息写入无锁队列；
+ * 渲染端在块边界处用pop()取出并应用（见AudioAPI::attachMidiInput）。
+ * 每个端口只能有一个生产者，多个输入源应各用一个端口
+ */
+class MidiInput {
+public:
+    static constexpr size_t QUEUE_SIZE = 64;   // 一个音频块内可缓冲的消息数
+
+    /**
+     * @brief 输入一个字节（仅生产者调用，可在中断中调用）
+     * @param byte 接收到的字节
+     * @param timestamp_us 接收时间（微秒）
+     */
+    void receive(uint8_t byte, uint32_t timestamp_us);
+
+    /**
+     * @brief 输入一段字节（仅生产者调用）
+     * @param data 字节数据
+     * @param size 字节数
+     * @param timestamp_us 接收时间（微秒）
+     */
+    void receive(const uint8_t* data, size_t size, uint32_t timestamp_us);
+
+    /**
+     * @brief 取出一条消息（仅消费者调用）
+     * @param message 输出消息
+     * @return 队列为空时返回false
+     */
+    bool pop(MidiMessage& message) { return queue_.pop(message); }
+
+    /**
+     * @brief 是否有待处理的消息
+     * @return 是否有消息
+     */
+    bool pending() const { return !queue_.empty(); }
+
+    /**
+     * @brief 队列已满而丢弃的消息数
+     * @return 丢弃数
+     */
+    uint32_t droppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    MidiStreamParser parser_;
+    SPSCQueue<MidiMessage, QUEUE_SIZE> queue_;
+    std::atomic<uint32_t> dropped_{0};
+};
+
+} // namespace Audio
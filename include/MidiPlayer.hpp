@@ -0,0 +1,73 @@
+#pragma once
+
+#include "MidiFile.hpp"
+#include "TempoMap.hpp"
+
+namespace Audio {
+
+/**
+ * @brief SMF流式播放调度
+ * 从合并后的事件流中逐个取出通道事件，并按文件中的速度事件换算为采样位置。
+ * 速度事件在遇到时就地处理：以当前位置为新原点重新设置单段速度表，
+ * 因此不需要预先扫描整个文件，内存占用固定
+ */
+class MidiPlayer {
+public:
+    /**
+     * @brief 绑定文件（不复制事件数据）
+     * @param file MIDI文件
+     * @param sample_rate 采样率
+     */
+    void setFile(const MidiFile& file, uint32_t sample_rate);
+
+    /**
+     * @brief 从文件开头重新开始
+     * @param start_sample 文件开头对应的采样位置（循环播放时为上一遍的结束位置）
+     */
+    void restart(uint64_t start_sample);
+
+    /**
+     * @brief 修改采样率（之后的事件按新采样率从当前原点换算）
+     * @param sample_rate 采样率
+     */
+    void setSampleRate(uint32_t sample_rate);
+
+    /**
+     * @brief 是否还有待处理的通道事件
+     * @return 文件已播完时返回false
+     */
+    bool hasEvent() const { return has_event_; }
+
+    /**
+     * @brief 下一个通道事件
+     * @return 事件（hasEvent()为true时有效）
+     */
+    const MidiEvent& event() const { return event_; }
+
+    /**
+     * @brief 下一个通道事件的采样位置；文件已播完时为文件结束位置
+     * @return 采样位置
+     */
+    uint64_t eventSample() const { return event_sample_; }
+
+    /**
+     * @brief 前进到下一个通道事件（途中处理速度事件）
+     */
+    void next();
+
+private:
+    MidiEventStream stream_;
+    TempoMap tempo_;
+    uint32_t sample_rate_ = 44100;
+    uint64_t origin_tick_ = 0;      // 当前速度段起点tick
+    uint64_t origin_sample_ = 0;    // 当前速度段起点采样位置
+    MidiEvent event_;
+    uint64_t event_sample_ = 0;
+    bool has_event_ = false;
+
+    uint64_t tickToSample(uint64_t tick) const {
+        return origin_sample_ + tempo_.tickToSample(tick - origin_tick_);
+    }
+};
+
+} // namespace Audio
@@ -1,16 +1,30 @@
 #pragma once
 
+#include "AudioCore.hpp"
 #include "WaveGenerator.hpp"
+#include "VoicePool.hpp"
 #include "Notes.hpp"
+#include "NoteEvent.hpp"
+#include "TempoMap.hpp"
+#include "MidiPlayer.hpp"
 #include <vector>
 #include <memory>
 #include <cstdint>
 #include <string>
 
+/**
+ * @brief 最大同时发声数（与pin_config.hpp一致，可由编译选项覆盖）
+ */
+#ifndef AUDIO_MAX_POLYPHONY
+#define AUDIO_MAX_POLYPHONY 4
+#endif
+
 namespace Audio {
 
 /**
- * @brief 音符结构
+ * @brief 音符结构（构建器）
+ * 便于手写序列的接口；播放前转换为紧凑的NoteEvent，音序器内部不保存Note。
+ * 时长在默认毫秒时基下为毫秒，设置其他速度表后按tick解释
  */
 struct Note {
     float frequency;
@@ -21,10 +35,18 @@ struct Note {
     
     Note(float freq, uint32_t dur, uint32_t pause = 0, float vol = 1.0f, const std::string& note_name = "")
         : frequency(freq), duration_ms(dur), pause_ms(pause), volume(vol), name(note_name) {}
+
+    /**
+     * @brief 转换为音符事件（名称被驻留，需在控制端调用）
+     * @return 音符事件
+     */
+    NoteEvent toEvent() const {
+        return makeNoteEvent(frequency, duration_ms, pause_ms, volume, NoteNames::intern(name.c_str()));
+    }
 };
 
 /**
- * @brief 音乐序列类型
+ * @brief 音乐序列类型（Note构建器列表）
  */
 using MusicSequence = std::vector<Note>;
 
@@ -45,17 +67,46 @@ enum class PlaybackState {
  */
 class MusicSequencer {
 public:
+    /**
+     * @brief 复音声部池（容量由AUDIO_MAX_POLYPHONY决定）
+     */
+    using Voices = VoicePool<AUDIO_MAX_POLYPHONY>;
+
+    // MIDI打击乐通道（第10通道，从0计为9），MIDI文件与MIDI输入都忽略此通道
+    static constexpr uint8_t MIDI_PERCUSSION_CHANNEL = 9;
+
     MusicSequencer();
     ~MusicSequencer();
 
     /**
-     * @brief 设置音符序列
+     * @brief 设置音符序列（转换为事件并复制，会分配内存）
      * @param sequence 音符序列
      */
     void setSequence(const MusicSequence& sequence);
 
     /**
-     * @brief 添加单个音符
+     * @brief 直接播放外部事件序列（零复制，不分配内存）
+     * 序列可位于flash；播放期间数据必须保持有效
+     * @param events 事件序列视图
+     */
+    void setSequence(EventSequence events);
+
+    /**
+     * @brief 播放标准MIDI文件（就地流式读取，不复制、不展开）
+     * 文件镜像在播放期间必须保持有效；速度取自文件中的速度事件
+     * @param file 已打开的MIDI文件
+     */
+    void setMidiFile(const MidiFile& file);
+
+    /**
+     * @brief 与外部事件缓冲交换内容（不分配内存）
+     * 调用后原缓冲被交换到参数中，由调用方负责释放
+     * @param events 事件缓冲
+     */
+    void swapSequence(std::vector<NoteEvent>& events);
+
+    /**
+     * @brief 添加单个音符（追加到内部缓冲，正在引用外部序列时先复制一份）
      * @param note 音符
      */
     void addNote(const Note& note);
@@ -87,11 +138,63 @@ public:
     void playNote(size_t index);
 
     /**
-     * @brief 设置波形类型
+     * @brief 设置速度表（序列时长按其tick解释，默认为毫秒时基）
+     * 正在播放时从当前音符起点按新速度表重新对齐
+     * @param tempo_map 速度表
+     */
+    void setTempoMap(const TempoMap& tempo_map);
+
+    /**
+     * @brief 获取速度表
+     * @return 速度表
+     */
+    const TempoMap& getTempoMap() const;
+
+    /**
+     * @brief 实时触发音符（与序列播放共用声部池）
+     * @param key 音符标识（MIDI音符号）
+     * @param frequency 频率（Hz）
+     * @param amplitude 振幅（0.0-1.0）
+     */
+    void noteOn(uint32_t key, float frequency, float amplitude);
+
+    /**
+     * @brief 按MIDI音符号实时触发音符（音高查表，不做浮点运算）
+     * @param key 音符标识
+     * @param note MIDI音符号（0-127）
+     * @param amplitude 振幅（0.0-1.0）
+     */
+    void midiNoteOn(uint32_t key, uint8_t note, float amplitude);
+
+    /**
+     * @brief 设置音高弯曲（作用于按MIDI音符号触发的全部声部）
+     * @param bend 偏移量（Q16半音，见Pitch::fromPitchBend）
+     */
+    void setPitchBend(int32_t bend);
+
+    /**
+     * @brief 释放实时触发的音符
+     * @param key 音符标识（MIDI音符号）
+     */
+    void noteOff(uint32_t key);
+
+    /**
+     * @brief 释放所有正在发声的音符（包括序列音符）
+     */
+    void allNotesOff();
+
+    /**
+     * @brief 设置波形类型（不分配内存，发声中的音符相位与包络连续）
      * @param wave_type 波形类型
      */
     void setWaveType(WaveType wave_type);
 
+    /**
+     * @brief 设置WAVETABLE波形使用的波表（只交换指针，不复制）
+     * @param table 波表（须在播放期间保持有效），nullptr时WAVETABLE按正弦波渲染
+     */
+    void setWavetable(const Wavetable* table);
+
     /**
      * @brief 获取当前播放状态
      * @return 播放状态
@@ -112,11 +215,19 @@ public:
 
     /**
      * @brief 生成音频样本
-     * @param samples 样本缓冲区
-     * @param sample_count 样本数量
+     * 序列音符与仍在Release的声部一起混音为单声道，再按声像扇出到各声道
+     * @param samples 交错样本缓冲区（frame_count * 声道数）
+     * @param frame_count 帧数
+     * @param layout 声道布局
      * @param sample_rate 采样率
      */
-    void generateSamples(int16_t* samples, size_t sample_count, uint32_t sample_rate);
+    void generateSamples(int16_t* samples, size_t frame_count, ChannelLayout layout, uint32_t sample_rate);
+
+    /**
+     * @brief 设置立体声声像
+     * @param pan 声像（-1.0=左，0.0=居中，1.0=右）
+     */
+    void setPan(float pan);
 
     /**
      * @brief 检查是否播放完成
@@ -130,44 +241,95 @@ public:
      */
     void setLoop(bool loop);
 
+    /**
+     * @brief 获取累计循环次数（每次循环回到开头加1，只增不减）
+     * @return 循环次数
+     */
+    uint32_t getLoopCount() const { return loop_count_; }
+
     /**
      * @brief 获取当前播放的音符
-     * @return 当前音符的指针，如果没有则返回nullptr
+     * @return 当前音符事件的指针，如果没有则返回nullptr
      */
-    const Note* getCurrentNote() const;
+    const NoteEvent* getCurrentNote() const;
 
 private:
-    MusicSequence sequence_;
-    std::unique_ptr<WaveGenerator<int16_t>> wave_generator_;
+    // 序列音符在声部池中使用的标识（与MIDI音符号不冲突）
+    static constexpr uint32_t SEQUENCE_KEY = UINT32_MAX;
+    // MIDI文件音符的标识：基值 | 通道 << 8 | 音符号（与实时音符不冲突）
+    static constexpr uint32_t MIDI_FILE_KEY_BASE = 0x10000;
+
+    EventSequence sequence_;            // 正在播放的序列（指向events_或外部数组）
+    std::vector<NoteEvent> events_;     // 内部持有的事件缓冲
+    Voices voices_;
     
     PlaybackState state_;
+    TempoMap tempo_map_;
+    size_t tempo_cursor_;           // 速度段游标（事件按时间顺序换算）
+    uint32_t sample_rate_;          // 速度表预计算所用的采样率
     size_t current_note_index_;
-    uint32_t current_note_samples_;
-    uint32_t note_duration_samples_;
-    uint32_t pause_duration_samples_;
+    uint64_t position_samples_;     // 序列时间轴上的当前采样位置
+    uint64_t note_start_tick_;      // 当前音符的起点tick
+    uint64_t event_tick_;           // 下一个事件的tick
+    uint64_t event_sample_;         // 下一个事件的采样位置
+    bool note_started_;
     bool in_pause_;
+    MidiPlayer midi_player_;
+    bool midi_active_;              // 当前播放源为MIDI文件
     bool loop_;
     bool finished_;
+    uint32_t loop_count_;
+
+    // 立体声声像增益（Q15，32768=1.0）
+    int32_t pan_gain_left_;
+    int32_t pan_gain_right_;
 
     /**
-     * @brief 更新当前音符状态
-     * @param sample_rate 采样率
+     * @brief 距下一个音符事件（音符开始、结束或暂停结束）的采样数
+     * @return 采样数，0表示当前采样处有事件，UINT32_MAX表示没有待处理事件
      */
-    void updateNoteState(uint32_t sample_rate);
+    uint32_t samplesUntilEvent() const;
+
+    /**
+     * @brief 处理当前采样处到期的音符事件（每次调用推进一个状态）
+     */
+    void updateNoteState();
+
+    /**
+     * @brief 将缓冲前部的单声道采样原地扇出为交错立体声
+     * @param samples 样本缓冲区（容量至少为 frame_count * 2）
+     * @param frame_count 帧数
+     */
+    void fanOutStereo(int16_t* samples, size_t frame_count) const;
+
+    /**
+     * @brief 处理MIDI文件中当前采样处到期的一个事件
+     */
+    void updateMidiState();
+
+    /**
+     * @brief 是否有可播放的内容（事件序列或MIDI文件）
+     * @return 是否有播放源
+     */
+    bool hasSource() const { return midi_active_ || !sequence_.empty(); }
 
     /**
      * @brief 开始播放下一个音符
-     * @param sample_rate 采样率
      */
-    void startNextNote(uint32_t sample_rate);
+    void startNextNote();
 
     /**
-     * @brief 计算音符持续时间的采样数
-     * @param duration_ms 持续时间（毫秒）
-     * @param sample_rate 采样率
-     * @return 采样数
+     * @brief 定位到指定音符的起点（尚未触发）
+     * 起点tick由之前各音符时长累加得到，采样位置由速度表换算
+     * @param index 音符索引
+     */
+    void rewind(size_t index);
+
+    /**
+     * @brief 设置下一个事件的位置
+     * @param tick 事件tick
      */
-    uint32_t msToSamples(uint32_t duration_ms, uint32_t sample_rate) const;
+    void scheduleEvent(uint64_t tick);
 };
 
 } // namespace Audio 
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace Audio {
+
+/**
+ * @brief 音符名称驻留表
+ * 名称只保存一份，事件中仅记录16位ID。字符数据存放在固定大小的静态池中，
+ * 驻留过程不分配堆内存；重复驻留同一名称返回同一ID。
+ * 只能在控制端调用intern()，渲染端只读
+ */
+class NoteNames {
+public:
+    static constexpr uint16_t NONE = 0;         // 无名称
+    static constexpr size_t MAX_NAMES = 64;     // 最多驻留的名称数
+    static constexpr size_t POOL_SIZE = 1024;   // 字符池大小（含结尾'\0'）
+
+    /**
+     * @brief 驻留名称
+     * @param name 名称（nullptr或空串返回NONE）
+     * @return 名称ID，表或字符池已满时返回NONE
+     */
+    static uint16_t intern(const char* name);
+
+    /**
+     * @brief 查询名称
+     * @param id 名称ID
+     * @return 名称，NONE或未知ID返回空串
+     */
+    static const char* lookup(uint16_t id);
+};
+
+/**
+ * @brief 紧凑音符事件（12字节，可平凡复制）
+ * 频率为Q16.16定点（Hz），音量为Q15（32768=1.0），时长以音序器tick计
+ * （默认毫秒时基下1 tick = 1 ms，见TempoMap）。
+ * 可用makeNoteEvent()在编译期构造整张序列，常量数组位于flash，无需复制到RAM
+ */
+struct NoteEvent {
+    uint32_t frequency_q16;     // 频率（Q16.16，Hz）
+    uint16_t duration_ticks;    // 发声时长（tick）
+    uint16_t pause_ticks;       // 之后的暂停时长（tick）
+    uint16_t volume_q15;        // 音量（Q15，32768=1.0）
+    uint16_t name_id;           // 驻留名称ID（NoteNames::NONE表示无名称）
+
+    /**
+     * @brief 获取频率
+     * @return 频率（Hz）
+     */
+    float frequency() const { return frequency_q16 * (1.0f / 65536.0f); }
+
+    /**
+     * @brief 获取音量
+     * @return 音量（0.0-1.0）
+     */
+    float volume() const { return volume_q15 * (1.0f / 32768.0f); }
+
+    /**
+     * @brief 获取名称
+     * @return 名称，无名称时为空串
+     */
+    const char* name() const { return NoteNames::lookup(name_id); }
+};
+
+static_assert(std::is_trivially_copyable_v<NoteEvent>, "NoteEvent必须可平凡复制");
+static_assert(sizeof(NoteEvent) == 12, "NoteEvent应保持12字节");
+
+/**
+ * @brief 构造音符事件（可在编译期求值）
+ * 时长超过65535 tick时截断，音量限制在0.0-1.0
+ * @param frequency 频率（Hz）
+ * @param duration_ticks 发声时长（tick，默认时基下为毫秒）
+ * @param pause_ticks 暂停时长（tick）
+ * @param volume 音量（0.0-1.0）
+ * @param name_id 驻留名称ID
+ * @return 音符事件
+ */
+constexpr NoteEvent makeNoteEvent(float frequency, uint32_t duration_ticks, uint32_t pause_ticks = 0,
+                                  float volume = 1.0f, uint16_t name_id = NoteNames::NONE) {
+    float clamped_volume = volume < 0.0f ? 0.0f : (volume > 1.0f ? 1.0f : volume);
+    return NoteEvent{
+        frequency > 0.0f ? static_cast<uint32_t>(frequency * 65536.0f + 0.5f) : 0u,
+        static_cast<uint16_t>(duration_ticks > UINT16_MAX ? UINT16_MAX : duration_ticks),
+        static_cast<uint16_t>(pause_ticks > UINT16_MAX ? UINT16_MAX : pause_ticks),
+        static_cast<uint16_t>(clamped_volume * 32768.0f + 0.5f),
+        name_id
+    };
+}
+
+/**
+ * @brief 音符事件序列视图（不持有数据）
+ * 可直接指向flash中的常量数组或调用方持有的缓冲，播放期间数据必须保持有效
+ */
+class EventSequence {
+public:
+    constexpr EventSequence() = default;
+
+    constexpr EventSequence(const NoteEvent* events, size_t count)
+        : events_(events), count_(count) {}
+
+    template<size_t N>
+    constexpr EventSequence(const NoteEvent (&events)[N])
+        : events_(events), count_(N) {}
+
+    EventSequence(const std::vector<NoteEvent>& events)
+        : events_(events.data()), count_(events.size()) {}
+
+    constexpr const NoteEvent* begin() const { return events_; }
+    constexpr const NoteEvent* end() const { return events_ + count_; }
+    constexpr const NoteEvent* data() const { return events_; }
+    constexpr size_t size() const { return count_; }
+    constexpr bool empty() const { return count_ == 0; }
+    constexpr const NoteEvent& operator[](size_t index) const { return events_[index]; }
+
+private:
+    const NoteEvent* events_ = nullptr;
+    size_t count_ = 0;
+};
+
+} // namespace Audio
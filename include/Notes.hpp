@@ -1,5 +1,11 @@
 #pragma once
 
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <string_view>
+#include "Pitch.hpp"
+
 namespace Audio {
 
 /**
@@ -7,12 +13,196 @@ namespace Audio {
  */
 namespace Notes {
     constexpr float C4 = 261.63f;   // DO
-    constexpr float D4 = 293.66f;   // RE  
+    constexpr float D4 = 293.66f;   // RE
     constexpr float E4 = 329.63f;   // MI
     constexpr float F4 = 349.23f;   // FA
     constexpr float G4 = 392.00f;   // SOL
     constexpr float A4 = 440.00f;   // LA
     constexpr float B4 = 493.88f;   // SI
+
+    constexpr uint8_t MIDI_A4 = 69; // A4的MIDI音符号
+    constexpr size_t MIDI_NOTE_COUNT = 128;
+    constexpr int INVALID_NOTE = -1;
+    constexpr uint8_t INVALID_NOTE_LITERAL = 0xFF;  // 非法音符名字面量在运行期的结果（超出0-127，noteOn()等会拒绝）
+
+    /**
+     * @brief 预计算相位步进的采样率
+     */
+    constexpr uint32_t TABLE_SAMPLE_RATES[] = {22050, 32000, 44100, 48000};
+    constexpr size_t TABLE_SAMPLE_RATE_COUNT = sizeof(TABLE_SAMPLE_RATES) / sizeof(TABLE_SAMPLE_RATES[0]);
+
+    namespace Detail {
+
+    /**
+     * @brief 一个八度内的十二平均律频率比 2^(k/12)
+     */
+    constexpr double SEMITONE_RATIOS[12] = {
+        1.0,                1.0594630943592953, 1.1224620483093730, 1.1892071150027210,
+        1.2599210498948732, 1.3348398541700344, 1.4142135623730951, 1.4983070768766815,
+        1.5874010519681994, 1.6817928305074290, 1.7817974362806785, 1.8877486253633868
+    };
+
+    /**
+     * @brief 十二平均律频率（A4=440Hz），八度部分只乘除2，没有累积误差
+     */
+    constexpr double equalTemperament(int note) {
+        int offset = note - MIDI_A4;
+        int octave = offset >= 0 ? offset / 12 : -((11 - offset) / 12);
+        double frequency = 440.0 * SEMITONE_RATIOS[offset - octave * 12];
+        for (; octave > 0; --octave) frequency *= 2.0;
+        for (; octave < 0; ++octave) frequency *= 0.5;
+        return frequency;
+    }
+
+    struct PitchTable {
+        std::array<float, MIDI_NOTE_COUNT> frequency{};
+        std::array<uint32_t, MIDI_NOTE_COUNT> frequency_q16{};
+        std::array<std::array<uint32_t, MIDI_NOTE_COUNT>, TABLE_SAMPLE_RATE_COUNT> phase_step{};
+    };
+
+    constexpr PitchTable makePitchTable() {
+        PitchTable table;
+        for (size_t n = 0; n < MIDI_NOTE_COUNT; ++n) {
+            table.frequency[n] = static_cast<float>(equalTemperament(static_cast<int>(n)));
+            table.frequency_q16[n] = Pitch::frequencyQ16(table.frequency[n]);
+            for (size_t r = 0; r < TABLE_SAMPLE_RATE_COUNT; ++r) {
+                table.phase_step[r][n] = Pitch::phaseStep(table.frequency_q16[n],
+                                                          Pitch::stepScale(TABLE_SAMPLE_RATES[r]));
+            }
+        }
+        return table;
+    }
+
+    constexpr char toUpper(char c) {
+        return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+
+    /**
+     * @brief 不区分大小写的前缀比较
+     */
+    constexpr bool startsWith(std::string_view text, std::string_view prefix) {
+        if (text.size() < prefix.size()) return false;
+        for (size_t i = 0; i < prefix.size(); ++i) {
+            if (toUpper(text[i]) != prefix[i]) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 非constexpr：在常量求值中调用即为编译错误（用于字面量中的非法音符名）
+     * 运行期返回INVALID_NOTE_LITERAL，而不是一个可以发声的音符
+     */
+    inline uint8_t invalidNoteName() { return INVALID_NOTE_LITERAL; }
+
+    } // namespace Detail
+
+    /**
+     * @brief 全部128个MIDI音符的频率与各采样率下的相位步进（编译期生成，位于flash）
+     */
+    constexpr Detail::PitchTable PITCH_TABLE = Detail::makePitchTable();
+
+    /**
+     * @brief MIDI音符号转换为频率（十二平均律，A4=440Hz，查表）
+     * @param note MIDI音符号（0-127）
+     * @return 频率（Hz）
+     */
+    constexpr float frequency(uint8_t note) {
+        return PITCH_TABLE.frequency[note & 0x7F];
+    }
+
+    /**
+     * @brief MIDI音符号对应的Q16频率（65536 = 1Hz）
+     * @param note MIDI音符号（0-127）
+     * @return Q16频率
+     */
+    constexpr uint32_t frequencyQ16(uint8_t note) {
+        return PITCH_TABLE.frequency_q16[note & 0x7F];
+    }
+
+    /**
+     * @brief MIDI音符号转换为频率（frequency()的别名）
+     * @param note MIDI音符号（0-127）
+     * @return 频率（Hz）
+     */
+    constexpr float midiToFrequency(uint8_t note) {
+        return frequency(note);
+    }
+
+    /**
+     * @brief 音符的32位相位步进
+     * TABLE_SAMPLE_RATES中的采样率直接查表，其他采样率按相同公式计算
+     * @param note MIDI音符号（0-127）
+     * @param sample_rate 采样率
+     * @return 相位步进，与setFrequency(frequency(note))的结果逐位一致
+     */
+    constexpr uint32_t phaseStep(uint8_t note, uint32_t sample_rate) {
+        for (size_t r = 0; r < TABLE_SAMPLE_RATE_COUNT; ++r) {
+            if (TABLE_SAMPLE_RATES[r] == sample_rate) {
+                return PITCH_TABLE.phase_step[r][note & 0x7F];
+            }
+        }
+        return Pitch::phaseStep(frequencyQ16(note), Pitch::stepScale(sample_rate));
+    }
+
+    /**
+     * @brief 解析音符名
+     * 字母名C D E F G A B或唱名DO RE MI FA SOL LA SI（不区分大小写），
+     * 后接任意个升号#或降号b，最后是八度（-1到9，省略时为4）。
+     * 例如"C#4"、"Bb2"、"A-1"、"sol5"、"DO"
+     * @param name 音符名
+     * @return MIDI音符号，无法解析或超出0-127时返回INVALID_NOTE
+     */
+    constexpr int parseNoteName(std::string_view name) {
+        constexpr struct { std::string_view name; int semitone; } PITCHES[] = {
+            {"DO", 0}, {"RE", 2}, {"MI", 4}, {"FA", 5}, {"SOL", 7}, {"LA", 9}, {"SI", 11},
+            {"C", 0}, {"D", 2}, {"E", 4}, {"F", 5}, {"G", 7}, {"A", 9}, {"B", 11},
+        };
+
+        int semitone = INVALID_NOTE;
+        size_t pos = 0;
+        for (const auto& pitch : PITCHES) {
+            if (Detail::startsWith(name, pitch.name)) {
+                semitone = pitch.semitone;
+                pos = pitch.name.size();
+                break;
+            }
+        }
+        if (semitone == INVALID_NOTE) return INVALID_NOTE;
+
+        for (; pos < name.size() && (name[pos] == '#' || name[pos] == 'b'); ++pos) {
+            semitone += (name[pos] == '#') ? 1 : -1;
+        }
+
+        int octave = 4;
+        if (pos < name.size()) {
+            // 负八度只有-1
+            bool negative = name[pos] == '-';
+            if (negative) ++pos;
+            if (pos + 1 != name.size() || name[pos] < '0' || name[pos] > '9') return INVALID_NOTE;
+            if (negative && name[pos] != '1') return INVALID_NOTE;
+            octave = negative ? -1 : (name[pos] - '0');
+        }
+
+        int note = (octave + 1) * 12 + semitone;
+        return (note < 0 || note >= static_cast<int>(MIDI_NOTE_COUNT)) ? INVALID_NOTE : note;
+    }
+}
+
+/**
+ * @brief 音符名字面量：using namespace Audio::NoteLiterals;
+ * "A4"_note为MIDI音符号，"C#5"_hz为频率；在常量表达式中使用非法音符名会编译失败，
+ * 在运行期分别得到Notes::INVALID_NOTE_LITERAL和0Hz
+ */
+namespace NoteLiterals {
+    constexpr uint8_t operator""_note(const char* name, size_t length) {
+        int note = Notes::parseNoteName(std::string_view(name, length));
+        return note == Notes::INVALID_NOTE ? Notes::Detail::invalidNoteName() : static_cast<uint8_t>(note);
+    }
+
+    constexpr float operator""_hz(const char* name, size_t length) {
+        uint8_t note = operator""_note(name, length);
+        return note < Notes::MIDI_NOTE_COUNT ? Notes::frequency(note) : 0.0f;
+    }
 }
 
-} // namespace Audio 
\ No newline at end of file
+} // namespace Audio
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "AudioCore.hpp"
+#include "FixedPoint.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Audio {
+
+/**
+ * @brief 离线音频核心（主机构建用）
+ * 不依赖Pico SDK，按调用尽快渲染，输出到内存和/或WAV文件。
+ * 用于在工作站或CI上剖析合成性能、生成回归测试用的PCM数据；
+ * 静音引脚等硬件功能以普通标志代替
+ */
+class OfflineAudioCore : public AudioCore {
+public:
+    OfflineAudioCore() = default;
+
+    /**
+     * @brief 析构函数（关闭未关闭的WAV文件）
+     */
+    ~OfflineAudioCore() override;
+
+    /**
+     * @brief 初始化音频系统
+     * @param config 音频配置（buffer_size为每次process()渲染的帧数）
+     * @return 是否初始化成功
+     */
+    bool initialize(const AudioConfig& config) override;
+
+    /**
+     * @brief 设置音频回调函数
+     * @param callback 音频回调函数
+     */
+    void setAudioCallback(AudioCallback callback) override;
+
+    /**
+     * @brief 启动音频输出
+     * @return 是否启动成功
+     */
+    bool start() override;
+
+    /**
+     * @brief 停止音频输出
+     */
+    void stop() override;
+
+    /**
+     * @brief 设置音量
+     * @param volume 音量值 (0-255)
+     */
+    void setVolume(uint8_t volume) override;
+
+    /**
+     * @brief 获取当前音量
+     * @return 当前音量值
+     */
+    uint8_t getVolume() const override;
+
+    /**
+     * @brief 检查音频系统是否正在运行
+     * @return 是否正在运行
+     */
+    bool isRunning() const override;
+
+    /**
+     * @brief 获取音频配置
+     * @return 当前音频配置
+     */
+    const AudioConfig& getConfig() const override;
+
+    /**
+     * @brief 设置静音状态（代替Pico上的DAC静音引脚）
+     * @param muted 是否静音
+     */
+    void setMuted(bool muted) override;
+
+    /**
+     * @brief 获取静音状态
+     * @return 是否静音
+     */
+    bool isMuted() const override;
+
+    /**
+     * @brief 渲染一个缓冲（运行中时）
+     */
+    void process() override;
+
+    /**
+     * @brief 读取渲染统计快照
+     * @param stats 输出快照
+     * @return AUDIO_ENABLE_STATS为0时返回false
+     */
+    bool getStats(AudioStats& stats) const override;
+
+    /**
+     * @brief 清零渲染统计
+     */
+    void resetStats() override;
+
+    /**
+     * @brief 获取时间戳
+     * 离线渲染没有实时时钟，以已渲染的音频时长作为时间
+     * @return 已渲染时长（微秒）
+     */
+    uint64_t getTimestampUs() const override;
+
+    /**
+     * @brief 回调是否按异步执行对待
+     * @return setCallbackAsync()设置的值
+     */
+    bool isCallbackAsync() const override;
+
+    /**
+     * @brief 模拟core1刷新模式：调用方在音频流运行时经命令队列传递状态变化
+     * 回调仍在render()的调用线程中执行，用于在主机上检查命令队列的行为
+     * @param async 是否按异步执行对待
+     */
+    void setCallbackAsync(bool async);
+
+    /**
+     * @brief 渲染指定帧数（运行中时，按buffer_size分块调用回调）
+     * @param frame_count 帧数
+     * @return 实际渲染的帧数
+     */
+    size_t render(size_t frame_count);
+
+    /**
+     * @brief 设置是否将输出保存到内存
+     * @param enabled 是否保存
+     */
+    void setCaptureEnabled(bool enabled);
+
+    /**
+     * @brief 获取已保存的交错采样
+     * @return 采样数据
+     */
+    const std::vector<int16_t>& getCapturedSamples() const;
+
+    /**
+     * @brief 清空已保存的采样
+     */
+    void clearCapturedSamples();
+
+    /**
+     * @brief 打开WAV文件，此后渲染的数据同时写入文件
+     * @param path 文件路径
+     * @return 是否打开成功
+     */
+    bool openWavFile(const std::string& path);
+
+    /**
+     * @brief 回填WAV头中的长度并关闭文件
+     */
+    void closeWavFile();
+
+    /**
+     * @brief 获取已渲染的总帧数
+     * @return 帧数
+     */
+    uint64_t getFramesRendered() const;
+
+private:
+    std::vector<int16_t> block_;
+    std::vector<int16_t> captured_;
+    bool capture_enabled_ = false;
+    bool muted_ = false;
+    bool callback_async_ = false;
+    uint64_t frames_rendered_ = 0;
+
+    std::FILE* wav_file_ = nullptr;
+    uint32_t wav_data_bytes_ = 0;
+
+#if AUDIO_ENABLE_STATS
+    AudioStatsCollector stats_;
+#endif
+
+    /**
+     * @brief 渲染一个块并分发到内存与文件
+     * @param frame_count 帧数（不超过buffer_size）
+     */
+    void renderBlock(size_t frame_count);
+
+    /**
+     * @brief 写入WAV文件头
+     * @param data_bytes 数据段字节数
+     */
+    void writeWavHeader(uint32_t data_bytes);
+};
+
+} // namespace Audio
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "FixedPoint.hpp"
+#include "SineTable.hpp"
+#include "HarmonicProfile.hpp"
+#include "Wavetable.hpp"
+
+namespace Audio {
+
+/**
+ * @brief 定点振荡器策略
+ * 供Voice<Osc, Env>在编译期组合，所有成员均为非虚内联函数：
+ *  - valueQ15(phase)：当前相位的Q15波形值
+ *  - CONTROL_INTERVAL：控制率状态的更新间隔（采样，0表示无控制率状态）
+ *  - control(envelope_q15)：在包络位置的控制网格点上调用，刷新控制率状态
+ *  - prepare(phase_step)：每个渲染段开始时调用，传入当前相位步进（带限振荡器据此确定修正窗口）
+ * WaveGenerator的定点路径也使用同一组波形函数，两条路径逐位一致
+ */
+
+/**
+ * @brief 正弦波振荡器（查表）
+ */
+struct SineOscillator {
+    static constexpr uint32_t CONTROL_INTERVAL = 0;
+
+    void control(int32_t) {}
+    void prepare(uint32_t) {}
+
+    static int32_t valueQ15(uint32_t phase) {
+        return SineTable::q15()[SineTable::index(phase)];
+    }
+};
+
+/**
+ * @brief 方波振荡器：前半周期为正，后半周期为负
+ */
+struct SquareOscillator {
+    static constexpr uint32_t CONTROL_INTERVAL = 0;
+
+    void control(int32_t) {}
+    void prepare(uint32_t) {}
+
+    static int32_t valueQ15(uint32_t phase) {
+        return (phase < 0x80000000) ? 32767 : -32767;
+    }
+};
+
+/**
+ * @brief 三角波振荡器
+ */
+struct TriangleOscillator {
+    static constexpr uint32_t CONTROL_INTERVAL = 0;
+
+    void control(int32_t) {}
+    void prepare(uint32_t) {}
+
+    static int32_t valueQ15(uint32_t phase) {
+        // 相位高16位：上升段 2p-1.0，下降段 3.0-2p（Q15）
+        int32_t p = static_cast<int32_t>(phase >> 16);
+        return (p < 32768) ? (2 * p - 32768) : (98304 - 2 * p);
+    }
+};
+
+/**
+ * @brief 锯齿波振荡器：线性上升
+ */
+struct SawtoothOscillator {
+    static constexpr uint32_t CONTROL_INTERVAL = 0;
+
+    void control(int32_t) {}
+    void prepare(uint32_t) {}
+
+    static int32_t valueQ15(uint32_t phase) {
+        return static_cast<int32_t>(phase >> 16) - 32768;
+    }
+};
+
+/**
+ * @brief 多谐波合成振荡器（钢琴音色）
+ * 谐波权重随包络电平变化，以控制率更新
+ * @tparam Profile 谐波音色配置（编译期确定谐波数量与强度）
+ */
+template<typename Profile = DefaultPianoProfile>
+struct HarmonicOscillator {
+    static constexpr uint32_t CONTROL_INTERVAL = 32; // 谐波权重的控制率（采样）
+
+    using Weights = typename Profile::Weights;
+
+    void control(int32_t envelope_q15) {
+        Profile::weightsQ15(envelope_q15, weights_);
+    }
+
+    void prepare(uint32_t) {}
+
+    int32_t valueQ15(uint32_t phase) const {
+        return synthesize(phase, weights_);
+    }
+
+    /**
+     * @brief 按给定谐波权重合成定点波形（谐波数为编译期常量，循环可完全展开）
+     * @param phase 相位
+     * @param weights 谐波权重（Q15）
+     * @return Q15波形值（可能超出±1.0，由输出饱和）
+     */
+    static int32_t synthesize(uint32_t phase, const Weights& weights) {
+        const auto& table = SineTable::q15();
+        int32_t sample = 0;
+        for (size_t h = 0; h < Profile::COUNT; ++h) {
+            uint32_t harmonic_phase = phase * static_cast<uint32_t>(h + 1);
+            sample += FixedPoint::mulQ15(table[SineTable::index(harmonic_phase)], weights[h]);
+        }
+        return sample;
+    }
+
+    Weights weights_{};
+};
+
+/**
+ * @brief PolyBLEP/PolyBLAMP修正（定点）
+ * 在距离不连续点不足一个采样的相位窗口内加上二阶多项式残差，抑制跳变与折角产生的混叠。
+ * 相位到窗口内归一化位置的除法在prepare()中化为一次32位倒数，每采样只有乘法与移位
+ */
+class PolyBlep {
+public:
+    /**
+     * @brief 设置相位步进（每个渲染段一次）
+     * @param phase_step 32位相位步进（频率过低、窗口不足2^16时关闭修正）
+     */
+    void prepare(uint32_t phase_step) {
+        uint32_t step16 = phase_step >> 16;
+        window_ = step16 == 0 ? 0 : phase_step;
+        reciprocal_ = step16 == 0 ? 0 : 0x80000000u / step16;
+        blamp_scale_q15_ = static_cast<int32_t>(phase_step >> 17) * 4 / 3;
+    }
+
+    /**
+     * @brief 单位跳变（+2，即-1到+1）的BLEP残差
+     * @param t 相对不连续点的相位
+     * @return Q15残差：跳变后为-(1-x)²，跳变前为+(1-x)²
+     */
+    int32_t stepResidual(uint32_t t) const {
+        if (t < window_) {
+            int32_t r = FixedPoint::Q15_ONE - position(t);
+            return -((r * r) >> 15);
+        }
+        uint32_t before = 0u - t;
+        if (before < window_) {
+            int32_t r = FixedPoint::Q15_ONE - position(before);
+            return (r * r) >> 15;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief 三角波折角（斜率每周期变化+8）的BLAMP残差
+     * @param t 相对折角的相位
+     * @return Q15残差：(4/3)·dt·(1-|x|)³
+     */
+    int32_t rampResidual(uint32_t t) const {
+        uint32_t distance = t < 0x80000000u ? t : 0u - t;
+        if (distance >= window_) return 0;
+        int32_t r = FixedPoint::Q15_ONE - position(distance);
+        int32_t r3 = (((r * r) >> 15) * r) >> 15;
+        return FixedPoint::mulQ15(r3, blamp_scale_q15_);
+    }
+
+private:
+    uint32_t window_ = 0;           // 修正窗口（等于相位步进）
+    uint32_t reciprocal_ = 0;       // 2^31 / (phase_step >> 16)
+    int32_t blamp_scale_q15_ = 0;   // (4/3)·dt（Q15）
+
+    /**
+     * @brief 窗口内的归一化位置 distance / phase_step（Q15，0到32767）
+     */
+    int32_t position(uint32_t distance) const {
+        uint32_t x = ((distance >> 16) * reciprocal_) >> 16;
+        return static_cast<int32_t>(x > 32767u ? 32767u : x);
+    }
+};
+
+/**
+ * @brief 带限锯齿波振荡器（PolyBLEP）
+ */
+struct BandLimitedSawtoothOscillator {
+    static constexpr uint32_t CONTROL_INTERVAL = 0;
+
+    void control(int32_t) {}
+    void prepare(uint32_t phase_step) { blep_.prepare(phase_step); }
+
+    int32_t valueQ15(uint32_t phase) const {
+        return SawtoothOscillator::valueQ15(phase) - blep_.stepResidual(phase);
+    }
+
+    /**
+     * @brief 浮点参考实现（WaveGenerator<float>使用）
+     */
+    static float reference(uint32_t phase, uint32_t phase_step) {
+        return static_cast<float>(phase) / 2147483648.0f - 1.0f - referenceStep(phase, phase_step);
+    }
+
+    /**
+     * @brief 浮点BLEP残差
+     */
+    static float referenceStep(uint32_t t, uint32_t phase_step) {
+        if (phase_step == 0) return 0.0f;
+        if (t < phase_step) {
+            float r = 1.0f - static_cast<float>(t) / phase_step;
+            return -r * r;
+        }
+        uint32_t before = 0u - t;
+        if (before < phase_step) {
+            float r = 1.0f - static_cast<float>(before) / phase_step;
+            return r * r;
+        }
+        return 0.0f;
+    }
+
+    PolyBlep blep_;
+};
+
+/**
+ * @brief 带限方波振荡器（PolyBLEP，上升沿在相位0，下降沿在相位1/2）
+ */
+struct BandLimitedSquareOscillator {
+    static constexpr uint32_t CONTROL_INTERVAL = 0;
+
+    void control(int32_t) {}
+    void prepare(uint32_t phase_step) { blep_.prepare(phase_step); }
+
+    int32_t valueQ15(uint32_t phase) const {
+        return SquareOscillator::valueQ15(phase) + blep_.stepResidual(phase)
+             - blep_.stepResidual(phase - 0x80000000u);
+    }
+
+    static float reference(uint32_t phase, uint32_t phase_step) {
+        float naive = phase < 0x80000000u ? 1.0f : -1.0f;
+        return naive + BandLimitedSawtoothOscillator::referenceStep(phase, phase_step)
+             - BandLimitedSawtoothOscillator::referenceStep(phase - 0x80000000u, phase_step);
+    }
+
+    PolyBlep blep_;
+};
+
+/**
+ * @brief 带限三角波振荡器（PolyBLAMP，波谷在相位0，波峰在相位1/2）
+ */
+struct BandLimitedTriangleOscillator {
+    static constexpr uint32_t CONTROL_INTERVAL = 0;
+
+    void control(int32_t) {}
+    void prepare(uint32_t phase_step) { blep_.prepare(phase_step); }
+
+    int32_t valueQ15(uint32_t phase) const {
+        return TriangleOscillator::valueQ15(phase) + blep_.rampResidual(phase)
+             - blep_.rampResidual(phase - 0x80000000u);
+    }
+
+    static float reference(uint32_t phase, uint32_t phase_step) {
+        float p = static_cast<float>(phase) / 4294967296.0f;
+        float naive = p < 0.5f ? 4.0f * p - 1.0f : 3.0f - 4.0f * p;
+        return naive + referenceRamp(phase, phase_step) - referenceRamp(phase - 0x80000000u, phase_step);
+    }
+
+    /**
+     * @brief 浮点BLAMP残差
+     */
+    static float referenceRamp(uint32_t t, uint32_t phase_step) {
+        uint32_t distance = t < 0x80000000u ? t : 0u - t;
+        if (distance >= phase_step) return 0.0f;
+        float r = 1.0f - static_cast<float>(distance) / phase_step;
+        return (4.0f / 3.0f) * (phase_step / 4294967296.0f) * r * r * r;
+    }
+
+    PolyBlep blep_;
+};
+
+/**
+ * @brief 多级波表振荡器（相邻表项Q15线性插值）
+ * prepare()按相位步进选出带限级别，每采样两次查表、一次乘法。
+ * 相位高SIZE_BITS位为表索引，其下15位为插值系数；保护采样使索引+1不需要取模。
+ * 波表由setTable()指定，必须在渲染期间保持有效（WaveVoice在未指定波表时按正弦波渲染）
+ */
+struct WavetableOscillator {
+    static constexpr uint32_t CONTROL_INTERVAL = 0;
+    static constexpr uint32_t INDEX_SHIFT = 32 - Wavetable::SIZE_BITS;
+    static constexpr uint32_t FRACTION_SHIFT = INDEX_SHIFT - 15;
+
+    void control(int32_t) {}
+
+    void prepare(uint32_t phase_step) {
+        level_ = table_->levels[Wavetable::levelFor(phase_step)].data();
+    }
+
+    int32_t valueQ15(uint32_t phase) const {
+        uint32_t index = phase >> INDEX_SHIFT;
+        int32_t fraction = static_cast<int32_t>((phase >> FRACTION_SHIFT) & 0x7FFF);
+        int32_t low = level_[index];
+        // |差值| ≤ 65534，乘以不超过32767的系数仍在int32范围内
+        return low + (((level_[index + 1] - low) * fraction) >> 15);
+    }
+
+    void setTable(const Wavetable* table) { table_ = table; }
+    const Wavetable* table() const { return table_; }
+
+    const Wavetable* table_ = nullptr;
+    const int16_t* level_ = nullptr;
+};
+
+} // namespace Audio
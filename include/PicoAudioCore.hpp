@@ -1,11 +1,24 @@
 #pragma once
 
 #include "AudioCore.hpp"
+#include "FixedPoint.hpp"
 #include "pico/audio_i2s.h"
+#include "pico/time.h"
 #include <algorithm>
+#include <atomic>
 
 namespace Audio {
 
+/**
+ * @brief 音频缓冲刷新模式
+ */
+enum class AudioRefillMode {
+    POLLING,        // 主循环中调用processAudio()刷新（默认）
+    DMA_IRQ,        // 在I2S DMA缓冲完成中断中刷新
+    TIMER_IRQ,      // 在定时器中断中周期性刷新
+    CORE1           // 整个渲染循环运行在core1上
+};
+
 /**
  * @brief Pico I2S配置结构
  */
@@ -16,6 +29,8 @@ struct PicoI2SConfig {
     uint8_t pio_sm = 0;              // PIO状态机
     uint8_t mute_pin = 22;           // 静音控制引脚（可选）
     bool enable_mute_control = true;  // 是否启用静音控制
+    AudioRefillMode refill_mode = AudioRefillMode::POLLING; // 缓冲刷新模式
+    uint32_t refill_budget_us = 0;      // 单次刷新的时间预算（0=半个缓冲周期）
 };
 
 /**
@@ -56,6 +71,7 @@ public:
 
     /**
      * @brief 停止音频输出
+     * CORE1模式下等待core1退出正在进行的刷新后才返回，之后渲染端不再调用回调
      */
     void stop() override;
 
@@ -83,23 +99,81 @@ public:
      */
     const AudioConfig& getConfig() const override;
 
+    /**
+     * @brief 获取缓冲欠载次数
+     * @return 自启动以来检测到的欠载次数
+     */
+    uint32_t getUnderrunCount() const override;
+
+    /**
+     * @brief 获取输出队列延迟
+     * 新渲染的缓冲排在队列中其余(当前队列深度-1)个缓冲之后
+     * @return 延迟（微秒）
+     */
+    uint32_t getOutputLatencyUs() const override;
+
+    /**
+     * @brief 获取当前有效队列深度
+     * @return 参与轮转的缓冲数量
+     */
+    uint32_t getQueueDepth() const;
+
+    /**
+     * @brief 读取渲染统计快照
+     * @param stats 输出快照
+     * @return AUDIO_ENABLE_STATS为0时返回false
+     */
+    bool getStats(AudioStats& stats) const override;
+
+    /**
+     * @brief 清零渲染统计（在下一次渲染时生效）
+     */
+    void resetStats() override;
+
+    /**
+     * @brief 获取单调时间戳
+     * @return time_us_64()
+     */
+    uint64_t getTimestampUs() const override;
+
+    /**
+     * @brief 进入回调互斥区（中断刷新模式下屏蔽中断）
+     */
+    void lockCallback() override;
+
+    /**
+     * @brief 离开回调互斥区
+     */
+    void unlockCallback() override;
+
+    /**
+     * @brief 回调是否在core1上异步执行
+     * @return CORE1模式下返回true
+     */
+    bool isCallbackAsync() const override;
+
     /**
      * @brief 处理音频缓冲
-     * 此方法应在主循环中定期调用
+     * 轮询模式下应在主循环中定期调用；中断刷新模式下无需调用
      */
     void processAudio();
 
     /**
-     * @brief 设置静音状态
+     * @brief 主循环处理（转发到processAudio()）
+     */
+    void process() override;
+
+    /**
+     * @brief 设置静音状态（控制DAC静音引脚）
      * @param muted 是否静音
      */
-    void setMuted(bool muted);
+    void setMuted(bool muted) override;
 
     /**
      * @brief 获取静音状态
      * @return 是否静音
      */
-    bool isMuted() const;
+    bool isMuted() const override;
 
     /**
      * @brief 获取I2S配置
@@ -115,6 +189,38 @@ private:
     audio_buffer_pool_t* audio_pool_ = nullptr;
     bool muted_ = false;
 
+    // 缓冲队列深度：多余的缓冲被“停放”不参与轮转，以此控制延迟
+    static constexpr uint32_t MIN_QUEUE_DEPTH = 2;
+    static constexpr uint32_t MAX_BUFFER_COUNT = 8;
+    static constexpr uint32_t SHRINK_AFTER_BUFFERS = 256;  // 连续余量充足多少个缓冲后变浅
+    static constexpr uint32_t HEADROOM_PERCENT = 50;       // 渲染耗时低于缓冲周期该比例视为余量充足
+    uint32_t buffer_count_ = 3;
+    volatile uint32_t queue_depth_ = 3;
+    audio_buffer_t* parked_buffers_[MAX_BUFFER_COUNT] = {};
+    uint32_t parked_count_ = 0;
+    uint32_t comfortable_buffers_ = 0;
+    uint32_t buffer_period_us_ = 0;
+
+#if AUDIO_ENABLE_STATS
+    AudioStatsCollector stats_;
+#endif
+
+    // 中断刷新相关
+    static PicoAudioCore* active_instance_;
+    repeating_timer_t refill_timer_ = {};
+    bool irq_attached_ = false;
+    bool primed_ = false;
+    volatile uint32_t underrun_count_ = 0;
+    uint32_t refill_budget_us_ = 0;
+    uint32_t saved_irq_status_ = 0;
+    uint32_t lock_depth_ = 0;
+
+    // core1渲染相关：start()/stop()各将请求代号加一（奇数为渲染、偶数为暂停），
+    // core1读到偶数代号后不再进入渲染，并将其写入确认代号，stop()等到确认后才返回
+    bool core1_launched_ = false;
+    std::atomic<uint32_t> render_request_{0};
+    std::atomic<uint32_t> render_idle_ack_{0};
+
     /**
      * @brief 设置音频格式
      */
@@ -133,11 +239,54 @@ private:
     bool initializeI2S();
 
     /**
-     * @brief 应用音量控制
-     * @param samples 样本数据
-     * @param count 样本数量
+     * @brief 刷新所有可用的缓冲区
+     * @param budget_us 时间预算（微秒），超出后不再领取新缓冲
+     * @return 本次填充的缓冲数量
+     */
+    size_t refillBuffers(uint32_t budget_us);
+
+    /**
+     * @brief 渲染并提交单个缓冲区
+     * @param buffer 音频缓冲区
+     * @return 渲染耗时（微秒）
+     */
+    uint32_t renderBuffer(audio_buffer_t* buffer);
+
+    /**
+     * @brief 自适应模式下根据欠载与渲染余量调整队列深度
+     * @param underrun 本次刷新是否检测到欠载
+     * @param render_us 本次刷新中单个缓冲的最大渲染耗时
+     * @param filled 本次刷新渲染的缓冲数量
+     */
+    void adaptQueueDepth(bool underrun, uint32_t render_us, size_t filled);
+
+    /**
+     * @brief 挂接中断刷新（DMA或定时器）
+     * @return 是否挂接成功
+     */
+    bool attachRefillIrq();
+
+    /**
+     * @brief 解除中断刷新
+     */
+    void detachRefillIrq();
+
+    /**
+     * @brief DMA缓冲完成中断处理函数
+     */
+    static void dmaIrqHandler();
+
+    /**
+     * @brief 定时器刷新回调
+     * @param rt 定时器句柄
+     * @return 是否继续重复
+     */
+    static bool timerRefillCallback(repeating_timer_t* rt);
+
+    /**
+     * @brief core1渲染循环入口
      */
-    void applyVolumeControl(int16_t* samples, size_t count);
+    static void core1Entry();
 
     /**
      * @brief 清理资源
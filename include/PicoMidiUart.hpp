@@ -0,0 +1,51 @@
+#pragma once
+
+#include "MidiInput.hpp"
+#include "hardware/uart.h"
+
+namespace Audio {
+
+/**
+ * @brief MIDI UART输入配置（DIN-5经光耦接入）
+ */
+struct PicoMidiUartConfig {
+    uint8_t uart_index = 1;         // UART实例（uart0被stdio占用）
+    uint8_t rx_pin = 5;             // RX引脚（UART1可用GP5/GP9/GP21）
+    uint32_t baud_rate = 31250;     // MIDI 1.0标准波特率
+};
+
+/**
+ * @brief Pico UART MIDI输入
+ * 在UART接收中断中逐字节读取FIFO并送入MidiInput，中断里只做解析和入队，
+ * 消息由渲染端在下一个块边界应用，主循环的延迟不影响输入到发声的延迟
+ */
+class PicoMidiUart {
+public:
+    explicit PicoMidiUart(const PicoMidiUartConfig& config = PicoMidiUartConfig{});
+    ~PicoMidiUart();
+
+    /**
+     * @brief 初始化UART并开启接收中断
+     * @param input 接收消息的MIDI输入端口（在end()之前必须保持有效）
+     * @return 该UART已被其他实例占用时返回false
+     */
+    bool begin(MidiInput& input);
+
+    /**
+     * @brief 关闭接收中断
+     */
+    void end();
+
+private:
+    PicoMidiUartConfig config_;
+    uart_inst_t* uart_ = nullptr;
+    MidiInput* input_ = nullptr;
+
+    static PicoMidiUart* instances_[2];
+
+    void onReceive();
+    static void uart0Handler();
+    static void uart1Handler();
+};
+
+} // namespace Audio
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace Audio {
+
+/**
+ * @brief 定点音高管线（适用于无FPU、无硬件除法的Cortex-M0+）
+ * 频率以Q16（65536 = 1Hz）表示，音高以Q16半音（65536 = 1个半音，MIDI音符号为整数部分）表示。
+ * 采样率变化时计算一次步进比例，之后频率→相位步进与音高→频率都只需整数乘法与移位，
+ * 音高弯曲、颤音与滑音可以在每个控制周期刷新
+ */
+namespace Pitch {
+
+constexpr int32_t SEMITONE = 1 << 16;           // Q16半音
+constexpr int32_t MAX_PITCH = (128 << 16) - 1;  // 最高音高（略低于MIDI 128）
+constexpr uint32_t MIN_SAMPLE_RATE = 4097;      // 最低采样率：2^44 / 4096 = 2^32 已超出32位步进比例
+constexpr uint32_t STEP_SCALE_SHIFT = 28;
+constexpr int EXP2_SEGMENTS_PER_SEMITONE = 16;
+constexpr int EXP2_SEGMENTS = 12 * EXP2_SEGMENTS_PER_SEMITONE;
+constexpr int EXP2_FRACTION_BITS = 16 - 4;      // 每段内的插值位数（Q16半音 / 16段）
+
+namespace Detail {
+
+/**
+ * @brief 编译期2^x（x在[-1, 1]内，泰勒级数收敛到double精度）
+ */
+constexpr double exp2Series(double x) {
+    constexpr double LN2 = 0.69314718055994530942;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 30; ++n) {
+        term *= x * LN2 / n;
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief 一个八度内的2^(k/192)（Q30），最后一项为2.0，供线性插值使用
+ */
+constexpr std::array<uint32_t, EXP2_SEGMENTS + 1> makeExp2Table() {
+    std::array<uint32_t, EXP2_SEGMENTS + 1> table{};
+    for (int k = 0; k <= EXP2_SEGMENTS; ++k) {
+        double ratio = k == EXP2_SEGMENTS ? 2.0 : exp2Series(static_cast<double>(k) / EXP2_SEGMENTS);
+        table[k] = static_cast<uint32_t>(ratio * (1u << 30) + 0.5);
+    }
+    return table;
+}
+
+} // namespace Detail
+
+constexpr std::array<uint32_t, EXP2_SEGMENTS + 1> EXP2_Q30 = Detail::makeExp2Table();
+
+/**
+ * @brief 最高八度起点C9（MIDI 120）的频率，Q18（440 * 2^5 / 2^(9/12)）
+ * 以最高八度为基准，低八度只需右移，不损失精度
+ */
+constexpr uint64_t C9_Q18 = static_cast<uint64_t>(
+    440.0 * 32.0 / Detail::exp2Series(0.75) * (1u << 18) + 0.5);
+constexpr int32_t C9_OCTAVE = 10;
+
+/**
+ * @brief 由音符号与音分构造音高
+ * @param note MIDI音符号
+ * @param cents 音分偏移（100音分 = 1个半音）
+ * @return Q16半音
+ */
+constexpr int32_t fromNote(uint8_t note, int32_t cents = 0) {
+    return (static_cast<int32_t>(note) << 16) + cents * SEMITONE / 100;
+}
+
+/**
+ * @brief MIDI弯音消息（0xE0）转换为音高偏移
+ * @param lsb 数据字节1（低7位）
+ * @param msb 数据字节2（高7位）
+ * @param range 弯音范围（半音，通用MIDI默认为2）
+ * @return Q16半音偏移
+ */
+constexpr int32_t fromPitchBend(uint8_t lsb, uint8_t msb, int32_t range = 2) {
+    int32_t value = ((static_cast<int32_t>(msb & 0x7F) << 7) | (lsb & 0x7F)) - 8192;
+    return value * range * (SEMITONE / 8192);
+}
+
+/**
+ * @brief 浮点频率转换为Q16（只在控制参数变化时调用）
+ * @param frequency 频率（Hz），限制在[0, 32768)
+ * @return Q16频率
+ */
+constexpr uint32_t frequencyQ16(float frequency) {
+    return frequency <= 0.0f ? 0u
+         : frequency >= 32768.0f ? 0x7FFFFFFFu
+         : static_cast<uint32_t>(frequency * 65536.0f);
+}
+
+/**
+ * @brief 采样率对应的步进比例 2^44 / sample_rate（每次采样率变化只做一次整数除法）
+ * @param sample_rate 采样率（不低于MIN_SAMPLE_RATE）
+ * @return 步进比例；采样率低于MIN_SAMPLE_RATE时返回0（相位不前进）
+ */
+constexpr uint32_t stepScale(uint32_t sample_rate) {
+    return sample_rate < MIN_SAMPLE_RATE ? 0u
+         : static_cast<uint32_t>((1ull << (16 + STEP_SCALE_SHIFT)) / sample_rate);
+}
+
+/**
+ * @brief Q16频率转换为32位相位步进（一次32x32→64乘法）
+ * @param frequency_q16 Q16频率
+ * @param step_scale stepScale()的结果
+ * @return 相位步进（频率不低于采样率时按2^32回绕）
+ */
+constexpr uint32_t phaseStep(uint32_t frequency_q16, uint32_t step_scale) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(frequency_q16) * step_scale) >> STEP_SCALE_SHIFT);
+}
+
+/**
+ * @brief 音高转换为Q16频率：八度部分移位，八度内查2^x表并线性插值
+ * 插值段为1/16半音，相对误差约2e-6（0.003音分）
+ * @param pitch Q16半音，限制在[0, MAX_PITCH]
+ * @return Q16频率
+ */
+constexpr uint32_t frequencyFromPitch(int32_t pitch) {
+    pitch = pitch < 0 ? 0 : (pitch > MAX_PITCH ? MAX_PITCH : pitch);
+    constexpr int32_t OCTAVE = 12 * SEMITONE;
+    int32_t octave = pitch / OCTAVE;
+    int32_t within = pitch - octave * OCTAVE;
+    int32_t index = within >> EXP2_FRACTION_BITS;
+    uint32_t fraction = static_cast<uint32_t>(within) & ((1u << EXP2_FRACTION_BITS) - 1);
+
+    uint32_t low = EXP2_Q30[index];
+    uint32_t ratio = low + static_cast<uint32_t>(
+        (static_cast<uint64_t>(EXP2_Q30[index + 1] - low) * fraction) >> EXP2_FRACTION_BITS);
+    uint32_t shift = 30 + 2 + static_cast<uint32_t>(C9_OCTAVE - octave);
+    return static_cast<uint32_t>((C9_Q18 * ratio + (1ull << (shift - 1))) >> shift);
+}
+
+/**
+ * @brief 音高直接转换为相位步进
+ * @param pitch Q16半音
+ * @param step_scale stepScale()的结果
+ * @return 相位步进
+ */
+constexpr uint32_t phaseStepFromPitch(int32_t pitch, uint32_t step_scale) {
+    return phaseStep(frequencyFromPitch(pitch), step_scale);
+}
+
+} // namespace Pitch
+
+} // namespace Audio
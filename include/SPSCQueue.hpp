@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+namespace Audio {
+
+/**
+ * @brief 单生产者单消费者无锁环形队列
+ * 生产者与消费者可位于不同核心或中断上下文，只使用32位原子读写，
+ * 不依赖CAS指令，适用于Cortex-M0+
+ * @tparam T 元素类型（必须可平凡复制）
+ * @tparam Capacity 队列容量（必须是2的幂）
+ */
+template<typename T, size_t Capacity>
+class SPSCQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity必须是2的幂");
+    static_assert(std::is_trivially_copyable_v<T>, "队列元素必须可平凡复制");
+
+public:
+    /**
+     * @brief 入队（仅生产者调用）
+     * @param item 元素
+     * @return 队列已满时返回false，不会阻塞
+     */
+    bool push(const T& item) {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        uint32_t tail = tail_.load(std::memory_order_acquire);
+        if (head - tail >= Capacity) {
+            return false;
+        }
+        buffer_[head & (Capacity - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 出队（仅消费者调用）
+     * @param item 输出元素
+     * @return 队列为空时返回false
+     */
+    bool pop(T& item) {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        uint32_t head = head_.load(std::memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+        item = buffer_[tail & (Capacity - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 读取队首元素但不出队（仅消费者调用）
+     * @param item 输出元素
+     * @return 队列为空时返回false
+     */
+    bool peek(T& item) const {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        uint32_t head = head_.load(std::memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+        item = buffer_[tail & (Capacity - 1)];
+        return true;
+    }
+
+    /**
+     * @brief 检查队列是否为空
+     * @return 是否为空
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 获取当前元素数量
+     * @return 元素数量
+     */
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 获取队列容量
+     * @return 容量
+     */
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    std::array<T, Capacity> buffer_{};
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> tail_{0};
+};
+
+} // namespace Audio
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <type_traits>
+
+/**
+ * @brief 正弦表是否复制到RAM
+ * 默认位于flash（XIP，只读数据段），不占用SRAM。只有在wave_benchmark实测
+ * RAM版本更快时才应通过CMake选项AUDIO_SINE_TABLE_IN_RAM开启
+ */
+#ifndef AUDIO_SINE_TABLE_IN_RAM
+#define AUDIO_SINE_TABLE_IN_RAM 0
+#endif
+
+namespace Audio {
+
+/**
+ * @brief 编译期生成的共享正弦表
+ * 所有振荡器共用同一份表，不在启动时计算
+ */
+namespace SineTable {
+
+constexpr size_t TABLE_BITS = 11;
+constexpr size_t TABLE_SIZE = size_t(1) << TABLE_BITS;
+
+/**
+ * @brief 相位转换为表索引（取相位高TABLE_BITS位）
+ * @param phase 32位相位
+ * @return 表索引
+ */
+constexpr uint32_t index(uint32_t phase) {
+    return phase >> (32 - TABLE_BITS);
+}
+
+namespace detail {
+
+constexpr double HALF_PI = 1.57079632679489661923;
+
+/**
+ * @brief 泰勒级数正弦（|x| <= π/2 时误差低于1e-15）
+ */
+constexpr double sinTaylor(double x) {
+    double term = x;
+    double sum = x;
+    double x2 = x * x;
+    for (int n = 1; n < 12; ++n) {
+        term *= -x2 / ((2.0 * n) * (2.0 * n + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief 第i个表项的正弦值，利用象限对称把自变量限制在 [0, π/2]
+ */
+constexpr double sinEntry(size_t i) {
+    constexpr size_t QUARTER = TABLE_SIZE / 4;
+    constexpr double STEP = HALF_PI / QUARTER;
+    switch (i / QUARTER) {
+        case 0:  return sinTaylor(STEP * i);
+        case 1:  return sinTaylor(STEP * (2 * QUARTER - i));
+        case 2:  return -sinTaylor(STEP * (i - 2 * QUARTER));
+        default: return -sinTaylor(STEP * (4 * QUARTER - i));
+    }
+}
+
+template<typename T>
+constexpr std::array<T, TABLE_SIZE> build() {
+    std::array<T, TABLE_SIZE> table{};
+    for (size_t i = 0; i < TABLE_SIZE; ++i) {
+        double value = sinEntry(i);
+        if constexpr (std::is_integral_v<T>) {
+            double scaled = value * 32767.0;
+            table[i] = static_cast<T>(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5);
+        } else {
+            table[i] = static_cast<T>(value);
+        }
+    }
+    return table;
+}
+
+} // namespace detail
+
+/**
+ * @brief Q15正弦表（flash只读数据段）
+ */
+inline constexpr std::array<int16_t, TABLE_SIZE> Q15 = detail::build<int16_t>();
+
+/**
+ * @brief 浮点正弦表（仅在使用浮点生成器时被链接）
+ */
+inline constexpr std::array<float, TABLE_SIZE> FLOAT = detail::build<float>();
+
+#if AUDIO_SINE_TABLE_IN_RAM
+/**
+ * @brief Q15正弦表的RAM副本（定义于SineTable.cpp）
+ */
+extern const std::array<int16_t, TABLE_SIZE> q15_ram;
+#endif
+
+/**
+ * @brief 获取振荡器使用的Q15正弦表
+ * @return 表引用（flash或RAM副本）
+ */
+inline const std::array<int16_t, TABLE_SIZE>& q15() {
+#if AUDIO_SINE_TABLE_IN_RAM
+    return q15_ram;
+#else
+    return Q15;
+#endif
+}
+
+} // namespace SineTable
+
+} // namespace Audio
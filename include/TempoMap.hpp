@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace Audio {
+
+/**
+ * @brief 速度表：PPQ tick时基到采样位置的换算
+ * 每个速度段在prepare()时预先算出起点采样位置和约分后的每tick采样数（分数），
+ * 之后每次换算只需一次查段和64位整数乘除。换算总是从段起点的绝对位置出发，
+ * 结果精确向下取整，不随音符数量累积误差；段数固定，不分配内存
+ */
+class TempoMap {
+public:
+    static constexpr size_t MAX_TEMPO_CHANGES = 32;     // 最多速度段数（含起始段）
+    static constexpr uint16_t DEFAULT_PPQ = 480;        // 每四分音符tick数
+    static constexpr uint32_t DEFAULT_TEMPO_US = 500000; // 每四分音符微秒数（120 BPM）
+
+    /**
+     * @brief 构造单一速度的速度表
+     * @param ppq 每四分音符tick数
+     * @param us_per_quarter 起始速度（每四分音符微秒数）
+     */
+    explicit TempoMap(uint16_t ppq = DEFAULT_PPQ, uint32_t us_per_quarter = DEFAULT_TEMPO_US);
+
+    /**
+     * @brief 毫秒时基（1 tick = 1 ms），音序器的默认时基
+     * @return 速度表
+     */
+    static TempoMap milliseconds();
+
+    /**
+     * @brief BPM转换为每四分音符微秒数
+     * @param bpm 每分钟四分音符数
+     * @return 每四分音符微秒数
+     */
+    static constexpr uint32_t bpmToTempo(float bpm) {
+        return bpm > 0.0f ? static_cast<uint32_t>(60000000.0f / bpm + 0.5f) : DEFAULT_TEMPO_US;
+    }
+
+    /**
+     * @brief 在指定tick处设置速度（同一tick已有速度时替换）
+     * @param tick 生效位置
+     * @param us_per_quarter 每四分音符微秒数
+     * @return 速度段已满或参数无效时返回false
+     */
+    bool setTempo(uint64_t tick, uint32_t us_per_quarter);
+
+    /**
+     * @brief 在指定tick处设置BPM
+     * @param tick 生效位置
+     * @param bpm 每分钟四分音符数
+     * @return 是否成功
+     */
+    bool setBpm(uint64_t tick, float bpm) { return setTempo(tick, bpmToTempo(bpm)); }
+
+    /**
+     * @brief 只保留起始段并设置其速度
+     * @param us_per_quarter 每四分音符微秒数
+     */
+    void reset(uint32_t us_per_quarter = DEFAULT_TEMPO_US);
+
+    /**
+     * @brief 预计算各段起点采样位置和换算系数（采样率变化或修改速度后调用）
+     * @param sample_rate 采样率
+     */
+    void prepare(uint32_t sample_rate);
+
+    /**
+     * @brief 获取预计算时使用的采样率
+     * @return 采样率，尚未预计算时为0
+     */
+    uint32_t preparedSampleRate() const { return sample_rate_; }
+
+    /**
+     * @brief 获取PPQ
+     * @return 每四分音符tick数
+     */
+    uint16_t ppq() const { return ppq_; }
+
+    /**
+     * @brief 获取速度段数
+     * @return 段数
+     */
+    size_t size() const { return count_; }
+
+    /**
+     * @brief 获取指定tick处的速度
+     * @param tick 位置
+     * @return 每四分音符微秒数
+     */
+    uint32_t tempoAt(uint64_t tick) const;
+
+    /**
+     * @brief tick换算为采样位置（需先prepare()）
+     * @param tick 位置
+     * @return 采样位置（向下取整）
+     */
+    uint64_t tickToSample(uint64_t tick) const {
+        size_t cursor = 0;
+        return tickToSample(tick, cursor);
+    }
+
+    /**
+     * @brief 带游标的tick换算，按时间顺序换算时查段为均摊O(1)
+     * @param tick 位置
+     * @param cursor 段游标（首次传0，之后原样传回）
+     * @return 采样位置（向下取整）
+     */
+    uint64_t tickToSample(uint64_t tick, size_t& cursor) const;
+
+private:
+    /**
+     * @brief 速度段
+     */
+    struct Segment {
+        uint64_t tick;                  // 起点tick
+        uint32_t us_per_quarter;        // 每四分音符微秒数
+        uint64_t start_sample;          // 起点采样位置（prepare()计算）
+        uint64_t rate_num;              // 每tick采样数 = rate_num / rate_den（prepare()约分）
+        uint64_t rate_den;
+    };
+
+    std::array<Segment, MAX_TEMPO_CHANGES> segments_{};
+    size_t count_ = 1;
+    uint16_t ppq_;
+    uint32_t sample_rate_ = 0;
+
+    size_t findSegment(uint64_t tick, size_t cursor) const;
+
+    /**
+     * @brief 段内tick偏移换算为采样偏移
+     * @param segment 速度段
+     * @param ticks 段内tick偏移
+     * @return 采样偏移（向下取整）
+     */
+    static uint64_t ticksToSamples(const Segment& segment, uint64_t ticks);
+};
+
+} // namespace Audio
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <algorithm>
+#include <type_traits>
+#include "Envelope.hpp"
+#include "WaveGenerator.hpp"
+#include "Oscillator.hpp"
+#include "FixedPoint.hpp"
+#include "Pitch.hpp"
+
+namespace Audio {
+
+/**
+ * @brief 声部公共状态与渲染循环
+ * 相位、频率、振幅与包络由振荡器无关的部分保存；renderWith()以振荡器类型为模板参数，
+ * 振荡器与包络的调用全部内联进内循环，没有虚调用
+ * @tparam Env 包络策略
+ * @tparam SampleType 采样类型（整数，定点路径）
+ */
+template<typename Env = LinearEnvelope, typename SampleType = int16_t>
+class VoiceCore {
+public:
+    static_assert(std::is_integral_v<SampleType>, "Voice只实现定点路径，浮点参考实现见WaveGenerator<float>");
+
+    /**
+     * @brief 设置采样率（只在变化时重新计算步进比例）
+     * @param sample_rate 采样率
+     */
+    void setSampleRate(uint32_t sample_rate) {
+        if (sample_rate != sample_rate_) {
+            sample_rate_ = sample_rate;
+            step_scale_ = Pitch::stepScale(sample_rate_);
+        }
+        updatePhaseStep();
+    }
+
+    /**
+     * @brief 设置频率
+     * @param frequency 频率（Hz）
+     */
+    void setFrequency(float frequency) {
+        frequency_q16_ = Pitch::frequencyQ16(frequency);
+        updatePhaseStep();
+    }
+
+    /**
+     * @brief 按音高设置频率（定点exp2查表，可在每个控制周期调用）
+     * @param pitch Q16半音（见Pitch::fromNote）
+     */
+    void setPitch(int32_t pitch) {
+        frequency_q16_ = Pitch::frequencyFromPitch(pitch);
+        updatePhaseStep();
+    }
+
+    /**
+     * @brief 同时设置频率与预先算好的相位步进
+     * @param frequency_q16 Q16频率，采样率变化时用它重新计算步进
+     * @param phase_step 当前采样率下的相位步进，通常来自Notes::phaseStep()
+     */
+    void setPhaseStep(uint32_t frequency_q16, uint32_t phase_step) {
+        frequency_q16_ = frequency_q16;
+        phase_step_ = phase_step;
+    }
+
+    /**
+     * @brief 设置振幅
+     * @param amplitude 振幅（0.0-1.0）
+     */
+    void setAmplitude(float amplitude) {
+        amplitude_q15_ = FixedPoint::fromFloatQ15(std::max(0.0f, amplitude));
+    }
+
+    /**
+     * @brief 重置相位与包络位置
+     */
+    void resetPhase() {
+        phase_ = 0;
+        envelope_.reset();
+    }
+
+    void setEnvelope(const ADSREnvelope& envelope) { envelope_.setEnvelope(envelope); }
+    void noteOn() { envelope_.noteOn(); }
+    void noteOff() { envelope_.noteOff(); }
+    bool isNoteOn() const { return envelope_.isNoteOn(); }
+    bool isActive() const { return envelope_.isActive(); }
+
+    /**
+     * @brief 获取当前包络电平
+     * @return Q24包络值（16777216=1.0）
+     */
+    int32_t envelopeLevelQ24() const { return envelope_.levelQ24(); }
+
+protected:
+    uint32_t sample_rate_ = 44100;
+    uint32_t step_scale_ = Pitch::stepScale(44100);
+    uint32_t frequency_q16_ = 440u << 16;
+    int32_t amplitude_q15_ = FixedPoint::Q15_ONE / 2;
+    uint32_t phase_ = 0;
+    uint32_t phase_step_ = 0;
+    Env envelope_;
+
+    void updatePhaseStep() {
+        phase_step_ = Pitch::phaseStep(frequency_q16_, step_scale_);
+    }
+
+    /**
+     * @brief 按包络线性段渲染整块
+     * 有控制率状态的振荡器在包络位置的CONTROL_INTERVAL网格点上刷新，
+     * 因此输出与调用分块无关；带限振荡器在开始时按当前相位步进确定修正窗口
+     * @tparam Osc 振荡器策略
+     * @param osc 振荡器
+     * @param samples 输出缓冲区
+     * @param count 采样数量
+     */
+    template<typename Osc>
+    void renderWith(Osc& osc, SampleType* samples, size_t count) {
+        osc.prepare(phase_step_);
+        size_t done = 0;
+        while (done < count) {
+            auto segment = envelope_.segment();
+            size_t length = std::min<size_t>(count - done, segment.length);
+            if constexpr (Osc::CONTROL_INTERVAL > 0) {
+                uint32_t grid_offset = envelope_.position() % Osc::CONTROL_INTERVAL;
+                length = std::min<size_t>(length, Osc::CONTROL_INTERVAL - grid_offset);
+                if (grid_offset == 0) {
+                    osc.control(segment.level >> 9);
+                }
+            }
+
+            int32_t envelope = segment.level;
+            const int32_t step = segment.step;
+            const int32_t amplitude = amplitude_q15_;
+            uint32_t phase = phase_;
+            const uint32_t phase_step = phase_step_;
+            SampleType* out = samples + done;
+
+            for (size_t i = 0; i < length; ++i) {
+                int32_t gain = FixedPoint::mulQ15(envelope >> 9, amplitude);
+                out[i] = FixedPoint::saturate16(FixedPoint::mulQ15(osc.valueQ15(phase), gain));
+                phase += phase_step;
+                envelope += step;
+            }
+
+            phase_ = phase;
+            envelope_.advance(static_cast<uint32_t>(length));
+            done += length;
+        }
+    }
+};
+
+/**
+ * @brief 编译期组合振荡器与包络的声部
+ * 没有虚函数，render()中的波形、包络与饱和全部内联，编译器可以展开内循环。
+ * 输出与对应的WaveGenerator<int16_t>逐位一致
+ * @tparam Osc 振荡器策略（见Oscillator.hpp）
+ * @tparam Env 包络策略
+ * @tparam SampleType 采样类型
+ */
+template<typename Osc, typename Env = LinearEnvelope, typename SampleType = int16_t>
+class Voice : public VoiceCore<Env, SampleType> {
+public:
+    /**
+     * @brief 块渲染
+     * @param samples 输出缓冲区
+     * @param count 采样数量
+     */
+    void render(SampleType* samples, size_t count) {
+        this->renderWith(osc_, samples, count);
+    }
+
+    Osc& oscillator() { return osc_; }
+
+private:
+    Osc osc_;
+};
+
+/**
+ * @brief 运行时选择波形的声部（类型擦除层）
+ * 每种波形的振荡器都就地保存，波形只在块边界处按WaveType分派一次，
+ * 块内仍是对应Voice的静态内联循环。切换波形不分配内存，相位与包络保持连续
+ * @tparam Env 包络策略
+ * @tparam SampleType 采样类型
+ */
+template<typename Env = LinearEnvelope, typename SampleType = int16_t>
+class WaveVoice : public VoiceCore<Env, SampleType> {
+public:
+    /**
+     * @param type 初始波形类型
+     */
+    explicit WaveVoice(WaveType type = WaveType::SINE) : type_(type) {}
+
+    /**
+     * @brief 切换波形（O(1)）
+     * @param type 波形类型
+     */
+    void setWaveType(WaveType type) {
+        if (type == type_) return;
+        type_ = type;
+        if (type == WaveType::PIANO) {
+            // 当前位置可能不在控制网格上：按当前包络电平立即计算谐波权重
+            piano_.control(this->envelopeLevelQ24() >> 9);
+        }
+    }
+
+    WaveType waveType() const { return type_; }
+
+    /**
+     * @brief 设置WAVETABLE波形使用的波表（不复制，波表须在渲染期间保持有效）
+     * @param table 波表，nullptr时WAVETABLE按正弦波渲染
+     */
+    void setWavetable(const Wavetable* table) { wavetable_.setTable(table); }
+
+    /**
+     * @brief 块渲染（每块一次分派）
+     * @param samples 输出缓冲区
+     * @param count 采样数量
+     */
+    void render(SampleType* samples, size_t count) {
+        switch (type_) {
+            case WaveType::SQUARE: {
+                SquareOscillator square;
+                this->renderWith(square, samples, count);
+                break;
+            }
+            case WaveType::TRIANGLE: {
+                TriangleOscillator triangle;
+                this->renderWith(triangle, samples, count);
+                break;
+            }
+            case WaveType::SAWTOOTH: {
+                SawtoothOscillator sawtooth;
+                this->renderWith(sawtooth, samples, count);
+                break;
+            }
+            case WaveType::PIANO:
+                this->renderWith(piano_, samples, count);
+                break;
+            case WaveType::SQUARE_BL: {
+                BandLimitedSquareOscillator square;
+                this->renderWith(square, samples, count);
+                break;
+            }
+            case WaveType::TRIANGLE_BL: {
+                BandLimitedTriangleOscillator triangle;
+                this->renderWith(triangle, samples, count);
+                break;
+            }
+            case WaveType::SAWTOOTH_BL: {
+                BandLimitedSawtoothOscillator sawtooth;
+                this->renderWith(sawtooth, samples, count);
+                break;
+            }
+            case WaveType::WAVETABLE:
+                if (wavetable_.table() != nullptr) {
+                    this->renderWith(wavetable_, samples, count);
+                    break;
+                }
+                [[fallthrough]];
+            case WaveType::SINE:
+            default: {
+                SineOscillator sine;
+                this->renderWith(sine, samples, count);
+                break;
+            }
+        }
+    }
+
+private:
+    HarmonicOscillator<> piano_;    // 唯一带控制率状态的振荡器
+    WavetableOscillator wavetable_; // 只保存波表指针
+    WaveType type_;
+};
+
+} // namespace Audio
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <algorithm>
+#include <array>
+#include "Voice.hpp"
+#include "FixedPoint.hpp"
+#include "Notes.hpp"
+
+namespace Audio {
+
+/**
+ * @brief 固定容量的复音声部池
+ * 每个声部是就地保存全部振荡器的WaveVoice，noteOn/noteOff/render/setWaveType均不分配内存，
+ * 渲染时每块每声部只按波形分派一次，没有虚调用。
+ * 声部耗尽时优先抢占释放阶段中最安静的声部，其次抢占最早分配的声部。
+ * 混音在int32累加器中完成，最后统一饱和到int16
+ * @tparam MaxVoices 最大同时发声数
+ */
+template<size_t MaxVoices>
+class VoicePool {
+public:
+    static_assert(MaxVoices > 0, "至少需要一个声部");
+
+    static constexpr size_t MAX_VOICES = MaxVoices;
+    static constexpr size_t MIX_CHUNK = 64; // 混音分块大小（帧）
+
+    using Generator = WaveVoice<>;
+
+    /**
+     * @brief 构造所有声部
+     * @param type 波形类型
+     * @param envelope ADSR包络
+     */
+    VoicePool(WaveType type, const ADSREnvelope& envelope)
+        : envelope_(envelope) {
+        for (auto& voice : voices_) {
+            voice.generator.setWaveType(type);
+            voice.generator.setEnvelope(envelope_);
+            voice.generator.setSampleRate(sample_rate_);
+        }
+    }
+
+    /**
+     * @brief 切换所有声部的波形（不分配内存，可在渲染端的块边界处调用）
+     * 发声中的声部保持相位、包络进度与按下/释放状态，不重新触发
+     * @param type 波形类型
+     */
+    void setWaveType(WaveType type) {
+        for (auto& voice : voices_) {
+            voice.generator.setWaveType(type);
+        }
+    }
+
+    /**
+     * @brief 获取当前波形类型
+     * @return 波形类型
+     */
+    WaveType waveType() const { return voices_[0].generator.waveType(); }
+
+    /**
+     * @brief 设置所有声部的WAVETABLE波表（只交换指针，可在渲染端的块边界处调用）
+     * @param table 波表（须在渲染期间保持有效），nullptr时WAVETABLE按正弦波渲染
+     */
+    void setWavetable(const Wavetable* table) {
+        for (auto& voice : voices_) {
+            voice.generator.setWavetable(table);
+        }
+    }
+
+    /**
+     * @brief 设置所有声部的包络
+     * @param envelope ADSR包络
+     */
+    void setEnvelope(const ADSREnvelope& envelope) {
+        envelope_ = envelope;
+        for (auto& voice : voices_) {
+            voice.generator.setEnvelope(envelope_);
+        }
+    }
+
+    /**
+     * @brief 设置采样率（未变化时直接返回）
+     * @param sample_rate 采样率
+     */
+    void setSampleRate(uint32_t sample_rate) {
+        if (sample_rate == sample_rate_) return;
+        sample_rate_ = sample_rate;
+        for (auto& voice : voices_) {
+            voice.generator.setSampleRate(sample_rate_);
+        }
+    }
+
+    /**
+     * @brief 触发音符（同一key已按下时重新触发该声部）
+     * @param key 音符标识
+     * @param frequency 频率（Hz）
+     * @param amplitude 振幅（0.0-1.0）
+     * @return 分配到的声部索引
+     */
+    size_t noteOn(uint32_t key, float frequency, float amplitude) {
+        size_t index = claimVoice(key);
+        voices_[index].generator.setFrequency(frequency);
+        voices_[index].pitch = NO_PITCH;
+        startVoice(voices_[index], key, amplitude);
+        return index;
+    }
+
+    /**
+     * @brief 按MIDI音符号触发音符（不做浮点运算）
+     * 没有音高弯曲时频率与相位步进直接查Notes::PITCH_TABLE，否则经定点exp2管线计算
+     * @param key 音符标识
+     * @param note MIDI音符号（0-127）
+     * @param amplitude 振幅（0.0-1.0）
+     * @return 分配到的声部索引
+     */
+    size_t noteOnMidi(uint32_t key, uint8_t note, float amplitude) {
+        size_t index = claimVoice(key);
+        Voice& voice = voices_[index];
+        voice.pitch = Pitch::fromNote(note);
+        if (pitch_bend_ == 0) {
+            voice.generator.setPhaseStep(Notes::frequencyQ16(note), Notes::phaseStep(note, sample_rate_));
+        } else {
+            voice.generator.setPitch(voice.pitch + pitch_bend_);
+        }
+        startVoice(voice, key, amplitude);
+        return index;
+    }
+
+    /**
+     * @brief 音高弯曲：移动所有按MIDI音符号触发的声部（包括释放中的声部）
+     * 只做整数运算，可在每个控制周期调用（颤音、滑音）
+     * @param bend 偏移量（Q16半音）
+     */
+    void setPitchBend(int32_t bend) {
+        if (bend == pitch_bend_) return;
+        pitch_bend_ = bend;
+        for (auto& voice : voices_) {
+            if (voice.pitch != NO_PITCH) {
+                voice.generator.setPitch(voice.pitch + pitch_bend_);
+            }
+        }
+    }
+
+    /**
+     * @brief 获取当前音高弯曲
+     * @return 偏移量（Q16半音）
+     */
+    int32_t pitchBend() const { return pitch_bend_; }
+
+    /**
+     * @brief 释放指定key的音符（进入Release阶段）
+     * @param key 音符标识
+     */
+    void noteOff(uint32_t key) {
+        for (auto& voice : voices_) {
+            if (voice.key == key && voice.generator.isNoteOn()) {
+                voice.generator.noteOff();
+            }
+        }
+    }
+
+    /**
+     * @brief 释放所有按下中的音符
+     */
+    void releaseAll() {
+        for (auto& voice : voices_) {
+            if (voice.generator.isNoteOn()) {
+                voice.generator.noteOff();
+            }
+        }
+    }
+
+    /**
+     * @brief 立即静音所有声部（不经过Release）
+     */
+    void reset() {
+        pitch_bend_ = 0;
+        for (auto& voice : voices_) {
+            voice.pitch = NO_PITCH;
+            voice.generator.noteOff();
+            voice.generator.resetPhase();
+        }
+    }
+
+    /**
+     * @brief 获取正在发声的声部数
+     * @return 声部数
+     */
+    size_t activeCount() const {
+        size_t count = 0;
+        for (const auto& voice : voices_) {
+            if (voice.generator.isActive()) ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief 渲染并混合所有发声中的声部
+     * @param samples 输出缓冲区
+     * @param count 采样数量
+     */
+    void render(int16_t* samples, size_t count) {
+        size_t done = 0;
+        while (done < count) {
+            size_t length = std::min(count - done, MIX_CHUNK);
+            std::fill(mix_buffer_.begin(), mix_buffer_.begin() + length, 0);
+
+            for (auto& voice : voices_) {
+                if (!voice.generator.isActive()) continue;
+                voice.generator.render(voice_buffer_.data(), length);
+                for (size_t i = 0; i < length; ++i) {
+                    mix_buffer_[i] += voice_buffer_[i];
+                }
+            }
+
+            int16_t* out = samples + done;
+            for (size_t i = 0; i < length; ++i) {
+                out[i] = FixedPoint::saturate16(mix_buffer_[i]);
+            }
+            done += length;
+        }
+    }
+
+private:
+    static constexpr int32_t NO_PITCH = -1;   // 按频率触发，不跟随音高弯曲
+
+    /**
+     * @brief 声部
+     */
+    struct Voice {
+        Generator generator;        // 声部状态与各波形的振荡器
+        uint32_t key = 0;           // 音符标识
+        uint32_t age = 0;           // 分配序号（越小越早）
+        int32_t pitch = NO_PITCH;   // 按音符号触发时的基准音高（Q16半音）
+    };
+
+    std::array<Voice, MaxVoices> voices_;
+    ADSREnvelope envelope_;
+    uint32_t sample_rate_ = 44100;
+    uint32_t next_age_ = 0;
+    int32_t pitch_bend_ = 0;
+
+    std::array<int32_t, MIX_CHUNK> mix_buffer_{};
+    std::array<int16_t, MIX_CHUNK> voice_buffer_{};
+
+    size_t claimVoice(uint32_t key) const {
+        size_t index = findHeld(key);
+        return index == MaxVoices ? allocateVoice() : index;
+    }
+
+    void startVoice(Voice& voice, uint32_t key, float amplitude) {
+        voice.key = key;
+        voice.age = next_age_++;
+        // 空闲声部从零相位开始，保证输出与渲染分块无关；发声中的声部保持相位连续
+        if (!voice.generator.isActive()) {
+            voice.generator.resetPhase();
+        }
+        voice.generator.setAmplitude(amplitude);
+        voice.generator.noteOn();
+    }
+
+    size_t findHeld(uint32_t key) const {
+        for (size_t i = 0; i < MaxVoices; ++i) {
+            if (voices_[i].key == key && voices_[i].generator.isNoteOn()) return i;
+        }
+        return MaxVoices;
+    }
+
+    /**
+     * @brief 选择一个声部：空闲 > 释放中最安静 > 最早分配
+     */
+    size_t allocateVoice() const {
+        size_t quietest = MaxVoices;
+        int32_t quietest_level = INT32_MAX;
+        size_t oldest = 0;
+        uint32_t oldest_span = 0;
+
+        for (size_t i = 0; i < MaxVoices; ++i) {
+            const Generator& generator = voices_[i].generator;
+            if (!generator.isActive()) return i;
+
+            if (!generator.isNoteOn()) {
+                int32_t level = generator.envelopeLevelQ24();
+                if (level < quietest_level) {
+                    quietest_level = level;
+                    quietest = i;
+                }
+            }
+
+            // 以与next_age_的差值比较，序号回绕后仍然正确
+            uint32_t span = next_age_ - voices_[i].age;
+            if (span > oldest_span) {
+                oldest_span = span;
+                oldest = i;
+            }
+        }
+        return quietest != MaxVoices ? quietest : oldest;
+    }
+};
+
+} // namespace Audio
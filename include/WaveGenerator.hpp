@@ -5,6 +5,13 @@
 #include <vector>
 #include <memory>
 #include <array>
+#include <type_traits>
+#include "FixedPoint.hpp"
+#include "Envelope.hpp"
+#include "SineTable.hpp"
+#include "HarmonicProfile.hpp"
+#include "Oscillator.hpp"
+#include "Pitch.hpp"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -20,26 +27,27 @@ enum class WaveType {
     SQUARE,         // 方波
     TRIANGLE,       // 三角波
     SAWTOOTH,       // 锯齿波
-    PIANO           // 钢琴音色（多谐波合成）
-};
-
-/**
- * @brief ADSR包络参数
- */
-struct ADSREnvelope {
-    uint32_t attack_samples = 0;   // 攻击时间（采样数）
-    uint32_t decay_samples = 0;    // 衰减时间（采样数）
-    float sustain_level = 1.0f;    // 持续电平（0.0-1.0）
-    uint32_t release_samples = 0;  // 释放时间（采样数）
+    PIANO,          // 钢琴音色（多谐波合成）
+    SQUARE_BL,      // 带限方波（PolyBLEP）
+    TRIANGLE_BL,    // 带限三角波（PolyBLAMP）
+    SAWTOOTH_BL,    // 带限锯齿波（PolyBLEP）
+    WAVETABLE       // 多级波表（仅WaveVoice/VoicePool，需先设置波表；WaveFactory按正弦波创建）
 };
 
 /**
  * @brief 波形生成器基类模板
+ * 整数采样类型（如int16_t）使用纯定点路径：Q15波形、Q24包络累加器、饱和输出，
+ * 适用于无FPU的RP2040；浮点采样类型使用浮点路径
  * @tparam SampleType 采样数据类型
  */
 template<typename SampleType = int16_t>
 class WaveGenerator {
 public:
+    /**
+     * @brief 是否使用定点运算路径
+     */
+    static constexpr bool FIXED_POINT = std::is_integral_v<SampleType>;
+
     virtual ~WaveGenerator() = default;
 
     /**
@@ -72,12 +80,21 @@ public:
     virtual SampleType generateSample() = 0;
 
     /**
-     * @brief 批量生成采样
+     * @brief 批量生成采样（转发到render()）
      * @param samples 输出缓冲区
      * @param count 采样数量
      */
     virtual void generateSamples(SampleType* samples, size_t count);
 
+    /**
+     * @brief 块渲染
+     * 每块只有一次虚调用，派生类覆盖此方法以非虚内联循环渲染整块数据。
+     * 默认实现逐采样调用generateSample()
+     * @param samples 输出缓冲区
+     * @param count 采样数量
+     */
+    virtual void render(SampleType* samples, size_t count);
+
     /**
      * @brief 设置ADSR包络
      * @param envelope ADSR包络参数
@@ -94,18 +111,35 @@ public:
      */
     virtual void noteOff();
 
+    /**
+     * @brief 音符是否处于按下状态
+     * @return 是否按下
+     */
+    bool isNoteOn() const { return envelope_.isNoteOn(); }
+
+    /**
+     * @brief 是否仍在发声（按下中或Release尚未结束）
+     * @return 是否发声
+     */
+    bool isActive() const { return envelope_.isActive(); }
+
+    /**
+     * @brief 获取当前包络电平
+     * @return Q24包络值（16777216=1.0）
+     */
+    int32_t envelopeLevelQ24() const { return envelope_.levelQ24(); }
+
 protected:
     uint32_t sample_rate_ = 44100;
-    float frequency_ = 440.0f;
+    uint32_t step_scale_ = Pitch::stepScale(44100);
+    uint32_t frequency_q16_ = 440u << 16;
     float amplitude_ = 0.5f;
+    int32_t amplitude_q15_ = FixedPoint::Q15_ONE / 2;
     uint32_t phase_ = 0;
     uint32_t phase_step_ = 0;
     
-    // ADSR 包络相关
-    ADSREnvelope envelope_;
-    uint32_t envelope_position_ = 0;
-    uint32_t release_start_position_ = 0;
-    bool note_on_ = false;
+    // ADSR 包络（定点线性段由LinearEnvelope计算，浮点路径读取其参数与位置）
+    LinearEnvelope envelope_;
 
     /**
      * @brief 更新相位步进值
@@ -122,67 +156,205 @@ protected:
      * @brief 更新包络位置
      */
     virtual void updateEnvelope();
+
+    /**
+     * @brief 包络线性段
+     * ADSR各阶段均为线性，块内只需起点电平和斜率
+     */
+    struct EnvelopeSegment {
+        float level;        // 段起点电平
+        float step;         // 每采样电平增量
+        uint32_t length;    // 段内剩余采样数（UINT32_MAX表示直到下次状态变化）
+    };
+
+    /**
+     * @brief 定点包络线性段（Q8.24，16777216=1.0）
+     * 累加器比Q16多8位小数，长段结束时的累加误差低于0.02%
+     */
+    using FixedEnvelopeSegment = LinearEnvelope::Segment;
+
+    /**
+     * @brief 获取当前包络位置所在的线性段
+     * @return 包络线性段，与逐采样calculateEnvelope()结果一致
+     */
+    EnvelopeSegment currentEnvelopeSegment() const;
+
+    /**
+     * @brief 获取当前包络位置所在的定点线性段（只使用整数运算）
+     * @return 定点包络线性段
+     */
+    FixedEnvelopeSegment currentEnvelopeSegmentFixed() const { return envelope_.segment(); }
+
+    /**
+     * @brief 包络位置前进多个采样（等价于多次updateEnvelope()）
+     * @param count 采样数
+     */
+    void advanceEnvelope(uint32_t count) { envelope_.advance(count); }
+
+    /**
+     * @brief 按包络线性段渲染整块
+     * @tparam Saturate 是否对整数输出做饱和处理
+     * @tparam WaveFunc 波形函数 float(uint32_t phase, float envelope)，内联展开
+     * @param samples 输出缓冲区
+     * @param count 采样数量
+     * @param wave 波形函数
+     */
+    template<bool Saturate = false, typename WaveFunc>
+    void renderBlock(SampleType* samples, size_t count, WaveFunc wave);
+
+    /**
+     * @brief 按定点包络线性段渲染整块（纯整数内循环）
+     * @tparam WaveFunc 波形函数 int32_t(uint32_t phase)，返回Q15波形值
+     * @param samples 输出缓冲区
+     * @param count 采样数量
+     * @param wave 波形函数
+     */
+    template<typename WaveFunc>
+    void renderBlockFixed(SampleType* samples, size_t count, WaveFunc wave);
+
+    /**
+     * @brief 由当前包络与振幅计算定点增益
+     * @param envelope_q24 Q24包络值
+     * @return Q15增益
+     */
+    int32_t gainQ15(int32_t envelope_q24) const {
+        return FixedPoint::mulQ15(envelope_q24 >> 9, amplitude_q15_);
+    }
+
+    /**
+     * @brief 生成一个定点采样并推进相位与包络（逐采样路径）
+     * @param wave_q15 当前相位的Q15波形值
+     * @return 饱和后的采样
+     */
+    SampleType emitFixedSample(int32_t wave_q15);
+
+    /**
+     * @brief 浮点采样转换为目标类型
+     * @tparam Saturate 是否饱和
+     * @param sample 浮点采样
+     * @return 目标类型采样
+     */
+    template<bool Saturate = false>
+    static SampleType toSample(float sample);
 };
 
 /**
  * @brief 正弦波生成器
  */
 template<typename SampleType = int16_t>
-class SineWaveGenerator : public WaveGenerator<SampleType> {
+class SineWaveGenerator final : public WaveGenerator<SampleType> {
 public:
-    SineWaveGenerator();
     SampleType generateSample() override;
+    void render(SampleType* samples, size_t count) override;
 
 private:
-    static constexpr size_t TABLE_SIZE = 2048;
-    static std::array<float, TABLE_SIZE> sine_table_;
-    static bool table_initialized_;
-
-    static void initializeSineTable();
+    static float waveValue(uint32_t phase);
+    static int32_t waveValueQ15(uint32_t phase);
 };
 
 /**
  * @brief 方波生成器
  */
 template<typename SampleType = int16_t>
-class SquareWaveGenerator : public WaveGenerator<SampleType> {
+class SquareWaveGenerator final : public WaveGenerator<SampleType> {
 public:
     SampleType generateSample() override;
+    void render(SampleType* samples, size_t count) override;
+
+private:
+    static float waveValue(uint32_t phase);
+    static int32_t waveValueQ15(uint32_t phase);
 };
 
 /**
  * @brief 三角波生成器
  */
 template<typename SampleType = int16_t>
-class TriangleWaveGenerator : public WaveGenerator<SampleType> {
+class TriangleWaveGenerator final : public WaveGenerator<SampleType> {
 public:
     SampleType generateSample() override;
+    void render(SampleType* samples, size_t count) override;
+
+private:
+    static float waveValue(uint32_t phase);
+    static int32_t waveValueQ15(uint32_t phase);
 };
 
 /**
  * @brief 锯齿波生成器
  */
 template<typename SampleType = int16_t>
-class SawtoothWaveGenerator : public WaveGenerator<SampleType> {
+class SawtoothWaveGenerator final : public WaveGenerator<SampleType> {
 public:
     SampleType generateSample() override;
+    void render(SampleType* samples, size_t count) override;
+
+private:
+    static float waveValue(uint32_t phase);
+    static int32_t waveValueQ15(uint32_t phase);
 };
 
 /**
  * @brief 钢琴音色生成器（多谐波合成）
+ * @tparam Profile 谐波音色配置（编译期确定谐波数量与强度）
  */
-template<typename SampleType = int16_t>
-class PianoWaveGenerator : public WaveGenerator<SampleType> {
+template<typename SampleType = int16_t, typename Profile = DefaultPianoProfile>
+class PianoWaveGenerator final : public WaveGenerator<SampleType> {
 public:
-    PianoWaveGenerator();
     SampleType generateSample() override;
+    void render(SampleType* samples, size_t count) override;
 
 private:
-    static constexpr size_t TABLE_SIZE = 2048;
-    static std::array<float, TABLE_SIZE> sine_table_;
-    static bool table_initialized_;
+    static constexpr size_t NUM_HARMONICS = Profile::COUNT;
+    static constexpr uint32_t CONTROL_INTERVAL = HarmonicOscillator<Profile>::CONTROL_INTERVAL;
 
-    static void initializeSineTable();
+    using Weights = typename Profile::Weights;
+    using FloatWeights = std::array<float, NUM_HARMONICS>;
+
+    /**
+     * @brief 当前谐波权重
+     * 只在包络位置落在CONTROL_INTERVAL网格上时更新，
+     * 因此输出与render()的调用分块无关，且与逐采样路径逐位一致
+     */
+    std::conditional_t<WaveGenerator<SampleType>::FIXED_POINT, Weights, FloatWeights> weights_{};
+
+    /**
+     * @brief 由浮点包络计算浮点谐波权重（控制率调用）
+     * @param envelope 包络值（0.0-1.0）
+     * @param weights 输出权重
+     */
+    static void floatWeights(float envelope, FloatWeights& weights);
+
+    /**
+     * @brief 按给定谐波权重合成浮点波形
+     * @param phase 相位
+     * @param weights 谐波权重
+     * @return 波形值（可能超出±1.0，由输出饱和）
+     */
+    static float waveValue(uint32_t phase, const FloatWeights& weights);
+
+    /**
+     * @brief 按给定谐波权重合成定点波形
+     * @param phase 相位
+     * @param weights 谐波权重（Q15）
+     * @return Q15波形值（可能超出±1.0，由输出饱和）
+     */
+    static int32_t waveValueQ15(uint32_t phase, const Weights& weights);
+};
+
+/**
+ * @brief 带限波形生成器（PolyBLEP/PolyBLAMP）
+ * 修正窗口取决于相位步进，定点路径在每次渲染开始时按当前步进设置振荡器
+ * @tparam Osc 带限振荡器策略（BandLimitedSquareOscillator等，提供浮点参考reference()）
+ */
+template<typename Osc, typename SampleType = int16_t>
+class BandLimitedWaveGenerator final : public WaveGenerator<SampleType> {
+public:
+    SampleType generateSample() override;
+    void render(SampleType* samples, size_t count) override;
+
+private:
+    Osc osc_;
 };
 
 /**
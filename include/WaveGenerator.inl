@@ -1,5 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <climits>
+#include <type_traits>
+
 // WaveGenerator模板类实现文件
 namespace Audio {
 
@@ -7,29 +11,38 @@ namespace Audio {
 
 template<typename SampleType>
 void WaveGenerator<SampleType>::setSampleRate(uint32_t sample_rate) {
-    sample_rate_ = sample_rate;
+    if (sample_rate != sample_rate_) {
+        sample_rate_ = sample_rate;
+        step_scale_ = Pitch::stepScale(sample_rate_);
+    }
     updatePhaseStep();
 }
 
 template<typename SampleType>
 void WaveGenerator<SampleType>::setFrequency(float frequency) {
-    frequency_ = frequency;
+    frequency_q16_ = Pitch::frequencyQ16(frequency);
     updatePhaseStep();
 }
 
 template<typename SampleType>
 void WaveGenerator<SampleType>::setAmplitude(float amplitude) {
     amplitude_ = amplitude;
+    amplitude_q15_ = FixedPoint::fromFloatQ15(std::max(0.0f, amplitude));
 }
 
 template<typename SampleType>
 void WaveGenerator<SampleType>::resetPhase() {
     phase_ = 0;
-    envelope_position_ = 0;
+    envelope_.reset();
 }
 
 template<typename SampleType>
 void WaveGenerator<SampleType>::generateSamples(SampleType* samples, size_t count) {
+    render(samples, count);
+}
+
+template<typename SampleType>
+void WaveGenerator<SampleType>::render(SampleType* samples, size_t count) {
     for (size_t i = 0; i < count; ++i) {
         samples[i] = generateSample();
     }
@@ -37,107 +50,178 @@ void WaveGenerator<SampleType>::generateSamples(SampleType* samples, size_t coun
 
 template<typename SampleType>
 void WaveGenerator<SampleType>::setEnvelope(const ADSREnvelope& envelope) {
-    envelope_ = envelope;
+    envelope_.setEnvelope(envelope);
 }
 
 template<typename SampleType>
 void WaveGenerator<SampleType>::noteOn() {
-    envelope_position_ = 0;
-    note_on_ = true;
+    envelope_.noteOn();
 }
 
 template<typename SampleType>
 void WaveGenerator<SampleType>::noteOff() {
-    note_on_ = false;
-    release_start_position_ = envelope_position_;
+    envelope_.noteOff();
 }
 
 template<typename SampleType>
 void WaveGenerator<SampleType>::updatePhaseStep() {
-    phase_step_ = static_cast<uint32_t>((frequency_ * 4294967296.0) / sample_rate_);
+    phase_step_ = Pitch::phaseStep(frequency_q16_, step_scale_);
 }
 
 template<typename SampleType>
 float WaveGenerator<SampleType>::calculateEnvelope() {
-    if (!note_on_ && envelope_position_ == 0) {
+    const ADSREnvelope& params = envelope_.parameters();
+    uint32_t pos = envelope_.position();
+
+    if (!envelope_.isNoteOn() && pos == 0) {
         return 0.0f; // 音符未开始
     }
 
-    uint32_t pos = envelope_position_;
-    
-    if (note_on_) {
+    if (envelope_.isNoteOn()) {
         // 音符按下状态
-        if (pos < envelope_.attack_samples) {
+        if (pos < params.attack_samples) {
             // Attack阶段
-            return static_cast<float>(pos) / envelope_.attack_samples;
-        } else if (pos < envelope_.attack_samples + envelope_.decay_samples) {
+            return static_cast<float>(pos) / params.attack_samples;
+        } else if (pos < params.attack_samples + params.decay_samples) {
             // Decay阶段
-            uint32_t decay_pos = pos - envelope_.attack_samples;
-            float decay_ratio = static_cast<float>(decay_pos) / envelope_.decay_samples;
-            return 1.0f - decay_ratio * (1.0f - envelope_.sustain_level);
+            uint32_t decay_pos = pos - params.attack_samples;
+            float decay_ratio = static_cast<float>(decay_pos) / params.decay_samples;
+            return 1.0f - decay_ratio * (1.0f - params.sustain_level);
         } else {
             // Sustain阶段
-            return envelope_.sustain_level;
+            return params.sustain_level;
         }
     } else {
         // 音符释放状态
-        uint32_t release_pos = pos - release_start_position_;
-        if (release_pos >= envelope_.release_samples) {
+        uint32_t release_pos = pos - envelope_.releaseStart();
+        if (release_pos >= params.release_samples) {
             return 0.0f; // Release完成
         }
-        float release_ratio = static_cast<float>(release_pos) / envelope_.release_samples;
-        return envelope_.sustain_level * (1.0f - release_ratio);
+        float release_ratio = static_cast<float>(release_pos) / params.release_samples;
+        return params.sustain_level * (1.0f - release_ratio);
     }
 }
 
 template<typename SampleType>
 void WaveGenerator<SampleType>::updateEnvelope() {
-    if (note_on_ || envelope_position_ > release_start_position_) {
-        envelope_position_++;
-    }
+    // Release结束后停止前进，包络保持为0
+    envelope_.advance(1);
 }
 
-// ==================== SineWaveGenerator 实现 ====================
-
-// 静态成员定义
 template<typename SampleType>
-std::array<float, SineWaveGenerator<SampleType>::TABLE_SIZE> SineWaveGenerator<SampleType>::sine_table_;
+typename WaveGenerator<SampleType>::EnvelopeSegment WaveGenerator<SampleType>::currentEnvelopeSegment() const {
+    constexpr uint32_t UNBOUNDED = UINT32_MAX;
+    const ADSREnvelope& params = envelope_.parameters();
+    uint32_t pos = envelope_.position();
 
-template<typename SampleType>
-bool SineWaveGenerator<SampleType>::table_initialized_ = false;
+    if (!envelope_.isNoteOn() && pos == 0) {
+        return {0.0f, 0.0f, UNBOUNDED}; // 音符未开始
+    }
+
+    if (envelope_.isNoteOn()) {
+        uint32_t attack_end = params.attack_samples;
+        uint32_t decay_end = attack_end + params.decay_samples;
+        if (pos < attack_end) {
+            // Attack阶段
+            float step = 1.0f / params.attack_samples;
+            return {pos * step, step, attack_end - pos};
+        } else if (pos < decay_end) {
+            // Decay阶段
+            float step = -(1.0f - params.sustain_level) / params.decay_samples;
+            return {1.0f + (pos - attack_end) * step, step, decay_end - pos};
+        }
+        // Sustain阶段
+        return {params.sustain_level, 0.0f, UNBOUNDED};
+    }
+
+    // Release阶段
+    uint32_t release_pos = pos - envelope_.releaseStart();
+    if (release_pos >= params.release_samples) {
+        return {0.0f, 0.0f, UNBOUNDED};
+    }
+    float step = -params.sustain_level / params.release_samples;
+    EnvelopeSegment segment = {params.sustain_level + release_pos * step, step,
+                               params.release_samples - release_pos};
+
+    return segment;
+}
 
 template<typename SampleType>
-SineWaveGenerator<SampleType>::SineWaveGenerator() {
-    initializeSineTable();
+template<bool Saturate, typename WaveFunc>
+void WaveGenerator<SampleType>::renderBlock(SampleType* samples, size_t count, WaveFunc wave) {
+    size_t done = 0;
+    while (done < count) {
+        // 每个线性段只计算一次起点与斜率，段内无除法和分支
+        EnvelopeSegment segment = currentEnvelopeSegment();
+        size_t length = std::min<size_t>(count - done, segment.length);
+
+        float envelope = segment.level;
+        const float step = segment.step;
+        const float amplitude = amplitude_;
+        uint32_t phase = phase_;
+        const uint32_t phase_step = phase_step_;
+        SampleType* out = samples + done;
+
+        for (size_t i = 0; i < length; ++i) {
+            out[i] = toSample<Saturate>(wave(phase, envelope) * (envelope * amplitude));
+            phase += phase_step;
+            envelope += step;
+        }
+
+        phase_ = phase;
+        advanceEnvelope(static_cast<uint32_t>(length));
+        done += length;
+    }
 }
 
 template<typename SampleType>
-void SineWaveGenerator<SampleType>::initializeSineTable() {
-    if (!table_initialized_) {
-        for (size_t i = 0; i < TABLE_SIZE; ++i) {
-            sine_table_[i] = std::sin(2.0 * M_PI * i / TABLE_SIZE);
+template<typename WaveFunc>
+void WaveGenerator<SampleType>::renderBlockFixed(SampleType* samples, size_t count, WaveFunc wave) {
+    size_t done = 0;
+    while (done < count) {
+        FixedEnvelopeSegment segment = currentEnvelopeSegmentFixed();
+        size_t length = std::min<size_t>(count - done, segment.length);
+
+        int32_t envelope = segment.level;
+        const int32_t step = segment.step;
+        uint32_t phase = phase_;
+        const uint32_t phase_step = phase_step_;
+        SampleType* out = samples + done;
+
+        for (size_t i = 0; i < length; ++i) {
+            int32_t gain = gainQ15(envelope);
+            out[i] = FixedPoint::saturate16(FixedPoint::mulQ15(wave(phase), gain));
+            phase += phase_step;
+            envelope += step;
         }
-        table_initialized_ = true;
+
+        phase_ = phase;
+        advanceEnvelope(static_cast<uint32_t>(length));
+        done += length;
     }
 }
 
 template<typename SampleType>
-SampleType SineWaveGenerator<SampleType>::generateSample() {
-    // 获取正弦波值
-    uint32_t table_index = (this->phase_ >> 20) % TABLE_SIZE; // 取高位作为表索引
-    float wave_value = sine_table_[table_index];
-    
-    // 应用包络和振幅
-    float envelope = this->calculateEnvelope();
-    float sample = wave_value * envelope * this->amplitude_;
-    
+SampleType WaveGenerator<SampleType>::emitFixedSample(int32_t wave_q15) {
+    int32_t gain = gainQ15(currentEnvelopeSegmentFixed().level);
+
     // 更新相位和包络
-    this->phase_ += this->phase_step_;
-    this->updateEnvelope();
-    
-    // 转换为目标类型
+    phase_ += phase_step_;
+    updateEnvelope();
+
+    return FixedPoint::saturate16(FixedPoint::mulQ15(wave_q15, gain));
+}
+
+template<typename SampleType>
+template<bool Saturate>
+SampleType WaveGenerator<SampleType>::toSample(float sample) {
     if constexpr (std::is_same_v<SampleType, int16_t>) {
-        return static_cast<int16_t>(sample * 32767.0f);
+        float scaled = sample * 32767.0f;
+        if constexpr (Saturate) {
+            if (scaled > 32767.0f) scaled = 32767.0f;
+            if (scaled < -32767.0f) scaled = -32767.0f;
+        }
+        return static_cast<int16_t>(scaled);
     } else if constexpr (std::is_same_v<SampleType, float>) {
         return sample;
     } else {
@@ -145,159 +229,294 @@ SampleType SineWaveGenerator<SampleType>::generateSample() {
     }
 }
 
+// ==================== SineWaveGenerator 实现 ====================
+
+template<typename SampleType>
+float SineWaveGenerator<SampleType>::waveValue(uint32_t phase) {
+    return SineTable::FLOAT[SineTable::index(phase)]; // 取相位高位作为表索引
+}
+
+template<typename SampleType>
+int32_t SineWaveGenerator<SampleType>::waveValueQ15(uint32_t phase) {
+    return SineOscillator::valueQ15(phase);
+}
+
+template<typename SampleType>
+SampleType SineWaveGenerator<SampleType>::generateSample() {
+    if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+        return this->emitFixedSample(waveValueQ15(this->phase_));
+    } else {
+        // 获取正弦波值
+        float wave_value = waveValue(this->phase_);
+
+        // 应用包络和振幅
+        float envelope = this->calculateEnvelope();
+        float sample = wave_value * (envelope * this->amplitude_);
+
+        // 更新相位和包络
+        this->phase_ += this->phase_step_;
+        this->updateEnvelope();
+
+        return this->toSample(sample);
+    }
+}
+
+template<typename SampleType>
+void SineWaveGenerator<SampleType>::render(SampleType* samples, size_t count) {
+    if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+        this->renderBlockFixed(samples, count, [](uint32_t phase) { return waveValueQ15(phase); });
+    } else {
+        this->renderBlock(samples, count, [](uint32_t phase, float) { return waveValue(phase); });
+    }
+}
+
 // ==================== SquareWaveGenerator 实现 ====================
 
 template<typename SampleType>
-SampleType SquareWaveGenerator<SampleType>::generateSample() {
+float SquareWaveGenerator<SampleType>::waveValue(uint32_t phase) {
     // 方波：前半周期为正，后半周期为负
-    float wave_value = (this->phase_ < 0x80000000) ? 1.0f : -1.0f;
-    
-    // 应用包络和振幅
-    float envelope = this->calculateEnvelope();
-    float sample = wave_value * envelope * this->amplitude_;
-    
-    // 更新相位和包络
-    this->phase_ += this->phase_step_;
-    this->updateEnvelope();
-    
-    // 转换为目标类型
-    if constexpr (std::is_same_v<SampleType, int16_t>) {
-        return static_cast<int16_t>(sample * 32767.0f);
-    } else if constexpr (std::is_same_v<SampleType, float>) {
-        return sample;
+    return (phase < 0x80000000) ? 1.0f : -1.0f;
+}
+
+template<typename SampleType>
+int32_t SquareWaveGenerator<SampleType>::waveValueQ15(uint32_t phase) {
+    return SquareOscillator::valueQ15(phase);
+}
+
+template<typename SampleType>
+SampleType SquareWaveGenerator<SampleType>::generateSample() {
+    if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+        return this->emitFixedSample(waveValueQ15(this->phase_));
     } else {
-        return static_cast<SampleType>(sample);
+        float wave_value = waveValue(this->phase_);
+
+        // 应用包络和振幅
+        float envelope = this->calculateEnvelope();
+        float sample = wave_value * (envelope * this->amplitude_);
+
+        // 更新相位和包络
+        this->phase_ += this->phase_step_;
+        this->updateEnvelope();
+
+        return this->toSample(sample);
+    }
+}
+
+template<typename SampleType>
+void SquareWaveGenerator<SampleType>::render(SampleType* samples, size_t count) {
+    if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+        this->renderBlockFixed(samples, count, [](uint32_t phase) { return waveValueQ15(phase); });
+    } else {
+        this->renderBlock(samples, count, [](uint32_t phase, float) { return waveValue(phase); });
     }
 }
 
 // ==================== TriangleWaveGenerator 实现 ====================
 
 template<typename SampleType>
-SampleType TriangleWaveGenerator<SampleType>::generateSample() {
+float TriangleWaveGenerator<SampleType>::waveValue(uint32_t phase) {
     // 三角波：线性上升和下降
-    float normalized_phase = static_cast<float>(this->phase_) / 4294967296.0f;
-    float wave_value;
+    float normalized_phase = static_cast<float>(phase) / 4294967296.0f;
     
     if (normalized_phase < 0.5f) {
         // 上升段：0到1
-        wave_value = 4.0f * normalized_phase - 1.0f;
-    } else {
-        // 下降段：1到-1
-        wave_value = 3.0f - 4.0f * normalized_phase;
+        return 4.0f * normalized_phase - 1.0f;
     }
-    
-    // 应用包络和振幅
-    float envelope = this->calculateEnvelope();
-    float sample = wave_value * envelope * this->amplitude_;
-    
-    // 更新相位和包络
-    this->phase_ += this->phase_step_;
-    this->updateEnvelope();
-    
-    // 转换为目标类型
-    if constexpr (std::is_same_v<SampleType, int16_t>) {
-        return static_cast<int16_t>(sample * 32767.0f);
-    } else if constexpr (std::is_same_v<SampleType, float>) {
-        return sample;
+    // 下降段：1到-1
+    return 3.0f - 4.0f * normalized_phase;
+}
+
+template<typename SampleType>
+int32_t TriangleWaveGenerator<SampleType>::waveValueQ15(uint32_t phase) {
+    return TriangleOscillator::valueQ15(phase);
+}
+
+template<typename SampleType>
+SampleType TriangleWaveGenerator<SampleType>::generateSample() {
+    if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+        return this->emitFixedSample(waveValueQ15(this->phase_));
     } else {
-        return static_cast<SampleType>(sample);
+        float wave_value = waveValue(this->phase_);
+
+        // 应用包络和振幅
+        float envelope = this->calculateEnvelope();
+        float sample = wave_value * (envelope * this->amplitude_);
+
+        // 更新相位和包络
+        this->phase_ += this->phase_step_;
+        this->updateEnvelope();
+
+        return this->toSample(sample);
     }
 }
 
-// ==================== SawtoothWaveGenerator 实现 ====================
-
 template<typename SampleType>
-SampleType SawtoothWaveGenerator<SampleType>::generateSample() {
-    // 锯齿波：线性上升
-    float normalized_phase = static_cast<float>(this->phase_) / 4294967296.0f;
-    float wave_value = 2.0f * normalized_phase - 1.0f;
-    
-    // 应用包络和振幅
-    float envelope = this->calculateEnvelope();
-    float sample = wave_value * envelope * this->amplitude_;
-    
-    // 更新相位和包络
-    this->phase_ += this->phase_step_;
-    this->updateEnvelope();
-    
-    // 转换为目标类型
-    if constexpr (std::is_same_v<SampleType, int16_t>) {
-        return static_cast<int16_t>(sample * 32767.0f);
-    } else if constexpr (std::is_same_v<SampleType, float>) {
-        return sample;
+void TriangleWaveGenerator<SampleType>::render(SampleType* samples, size_t count) {
+    if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+        this->renderBlockFixed(samples, count, [](uint32_t phase) { return waveValueQ15(phase); });
     } else {
-        return static_cast<SampleType>(sample);
+        this->renderBlock(samples, count, [](uint32_t phase, float) { return waveValue(phase); });
     }
 }
 
-// ==================== PianoWaveGenerator 实现 ====================
+// ==================== SawtoothWaveGenerator 实现 ====================
 
-// 静态成员定义
 template<typename SampleType>
-std::array<float, PianoWaveGenerator<SampleType>::TABLE_SIZE> PianoWaveGenerator<SampleType>::sine_table_;
+float SawtoothWaveGenerator<SampleType>::waveValue(uint32_t phase) {
+    // 锯齿波：线性上升
+    float normalized_phase = static_cast<float>(phase) / 4294967296.0f;
+    return 2.0f * normalized_phase - 1.0f;
+}
 
 template<typename SampleType>
-bool PianoWaveGenerator<SampleType>::table_initialized_ = false;
+int32_t SawtoothWaveGenerator<SampleType>::waveValueQ15(uint32_t phase) {
+    return SawtoothOscillator::valueQ15(phase);
+}
 
 template<typename SampleType>
-PianoWaveGenerator<SampleType>::PianoWaveGenerator() {
-    initializeSineTable();
+SampleType SawtoothWaveGenerator<SampleType>::generateSample() {
+    if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+        return this->emitFixedSample(waveValueQ15(this->phase_));
+    } else {
+        float wave_value = waveValue(this->phase_);
+
+        // 应用包络和振幅
+        float envelope = this->calculateEnvelope();
+        float sample = wave_value * (envelope * this->amplitude_);
+
+        // 更新相位和包络
+        this->phase_ += this->phase_step_;
+        this->updateEnvelope();
+
+        return this->toSample(sample);
+    }
 }
 
 template<typename SampleType>
-void PianoWaveGenerator<SampleType>::initializeSineTable() {
-    if (!table_initialized_) {
-        for (size_t i = 0; i < TABLE_SIZE; ++i) {
-            sine_table_[i] = std::sin(2.0 * M_PI * i / TABLE_SIZE);
-        }
-        table_initialized_ = true;
+void SawtoothWaveGenerator<SampleType>::render(SampleType* samples, size_t count) {
+    if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+        this->renderBlockFixed(samples, count, [](uint32_t phase) { return waveValueQ15(phase); });
+    } else {
+        this->renderBlock(samples, count, [](uint32_t phase, float) { return waveValue(phase); });
     }
 }
 
-template<typename SampleType>
-SampleType PianoWaveGenerator<SampleType>::generateSample() {
-    static constexpr size_t NUM_HARMONICS = 6;
-    // 谐波强度
-    static const std::array<float, NUM_HARMONICS> harmonic_amplitudes = {
-        1.0f, 0.4f, 0.2f, 0.1f, 0.05f, 0.03f
-    };
-    
+// ==================== BandLimitedWaveGenerator 实现 ====================
+
+template<typename Osc, typename SampleType>
+SampleType BandLimitedWaveGenerator<Osc, SampleType>::generateSample() {
+    if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+        osc_.prepare(this->phase_step_);
+        return this->emitFixedSample(osc_.valueQ15(this->phase_));
+    } else {
+        float wave_value = Osc::reference(this->phase_, this->phase_step_);
+
+        // 应用包络和振幅
+        float envelope = this->calculateEnvelope();
+        float sample = wave_value * (envelope * this->amplitude_);
+
+        // 更新相位和包络
+        this->phase_ += this->phase_step_;
+        this->updateEnvelope();
+
+        return this->toSample(sample);
+    }
+}
+
+template<typename Osc, typename SampleType>
+void BandLimitedWaveGenerator<Osc, SampleType>::render(SampleType* samples, size_t count) {
+    if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+        osc_.prepare(this->phase_step_);
+        this->renderBlockFixed(samples, count, [this](uint32_t phase) { return osc_.valueQ15(phase); });
+    } else {
+        const uint32_t phase_step = this->phase_step_;
+        this->renderBlock(samples, count, [phase_step](uint32_t phase, float) {
+            return Osc::reference(phase, phase_step);
+        });
+    }
+}
+
+// ==================== PianoWaveGenerator 实现 ====================
+
+template<typename SampleType, typename Profile>
+void PianoWaveGenerator<SampleType, Profile>::floatWeights(float envelope, FloatWeights& weights) {
+    Weights weights_q15;
+    Profile::weightsQ15(FixedPoint::fromFloatQ15(envelope), weights_q15);
+    for (size_t h = 0; h < NUM_HARMONICS; ++h) {
+        weights[h] = weights_q15[h] * (1.0f / 32768.0f);
+    }
+}
+
+template<typename SampleType, typename Profile>
+float PianoWaveGenerator<SampleType, Profile>::waveValue(uint32_t phase, const FloatWeights& weights) {
     float sample = 0.0f;
-    float envelope = this->calculateEnvelope();
 
-    // 合成多个谐波
+    // 合成多个谐波（谐波数为编译期常量，循环可完全展开）
     for (size_t h = 0; h < NUM_HARMONICS; ++h) {
-        uint32_t harmonic_phase = (this->phase_ * (h + 1)) & 0xFFFFFFFF;
-        uint32_t table_index = (harmonic_phase >> 20) % TABLE_SIZE;
-        float harmonic_wave = sine_table_[table_index];
-        
-        // 应用谐波强度和包络衰减
-        float harmonic_amplitude = harmonic_amplitudes[h];
-        if (h > 0) {
-            // 高次谐波随包络衰减更快
-            harmonic_amplitude *= std::pow(envelope, static_cast<float>(h) * 0.5f + 1.0f);
-        }
-        
-        sample += harmonic_wave * harmonic_amplitude;
+        uint32_t harmonic_phase = phase * static_cast<uint32_t>(h + 1);
+        sample += SineTable::FLOAT[SineTable::index(harmonic_phase)] * weights[h];
     }
-    
-    // 应用总包络和振幅
-    sample *= envelope * this->amplitude_;
-    
-    // 更新相位和包络
-    this->phase_ += this->phase_step_;
-    this->updateEnvelope();
-    
-    // 转换为目标类型
-    if constexpr (std::is_same_v<SampleType, int16_t>) {
-        float scaled = sample * 32767.0f;
-        if (scaled > 32767.0f) scaled = 32767.0f;
-        if (scaled < -32767.0f) scaled = -32767.0f;
-        return static_cast<int16_t>(scaled);
-    } else if constexpr (std::is_same_v<SampleType, float>) {
-        return sample;
+    return sample;
+}
+
+template<typename SampleType, typename Profile>
+int32_t PianoWaveGenerator<SampleType, Profile>::waveValueQ15(uint32_t phase, const Weights& weights) {
+    return HarmonicOscillator<Profile>::synthesize(phase, weights);
+}
+
+template<typename SampleType, typename Profile>
+SampleType PianoWaveGenerator<SampleType, Profile>::generateSample() {
+    bool control_tick = this->envelope_.position() % CONTROL_INTERVAL == 0;
+    if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+        if (control_tick) {
+            Profile::weightsQ15(this->currentEnvelopeSegmentFixed().level >> 9, weights_);
+        }
+        return this->emitFixedSample(waveValueQ15(this->phase_, weights_));
     } else {
-        return static_cast<SampleType>(sample);
+        float envelope = this->calculateEnvelope();
+        if (control_tick) {
+            floatWeights(envelope, weights_);
+        }
+        float sample = waveValue(this->phase_, weights_);
+
+        // 应用总包络和振幅
+        sample *= envelope * this->amplitude_;
+
+        // 更新相位和包络
+        this->phase_ += this->phase_step_;
+        this->updateEnvelope();
+
+        return this->template toSample<true>(sample);
+    }
+}
+
+template<typename SampleType, typename Profile>
+void PianoWaveGenerator<SampleType, Profile>::render(SampleType* samples, size_t count) {
+    // 谐波权重以控制率更新：在包络位置的CONTROL_INTERVAL网格点上查表一次
+    size_t done = 0;
+    while (done < count) {
+        uint32_t grid_offset = this->envelope_.position() % CONTROL_INTERVAL;
+        if constexpr (WaveGenerator<SampleType>::FIXED_POINT) {
+            auto segment = this->currentEnvelopeSegmentFixed();
+            size_t length = std::min<size_t>({count - done, segment.length, CONTROL_INTERVAL - grid_offset});
+            if (grid_offset == 0) {
+                Profile::weightsQ15(segment.level >> 9, weights_);
+            }
+            this->renderBlockFixed(samples + done, length, [this](uint32_t phase) {
+                return waveValueQ15(phase, weights_);
+            });
+            done += length;
+        } else {
+            auto segment = this->currentEnvelopeSegment();
+            size_t length = std::min<size_t>({count - done, segment.length, CONTROL_INTERVAL - grid_offset});
+            if (grid_offset == 0) {
+                floatWeights(segment.level, weights_);
+            }
+            this->template renderBlock<true>(samples + done, length, [this](uint32_t phase, float) {
+                return waveValue(phase, weights_);
+            });
+            done += length;
+        }
     }
 }
 
@@ -316,9 +535,15 @@ std::unique_ptr<WaveGenerator<SampleType>> WaveFactory<SampleType>::create(WaveT
             return std::make_unique<SawtoothWaveGenerator<SampleType>>();
         case WaveType::PIANO:
             return std::make_unique<PianoWaveGenerator<SampleType>>();
+        case WaveType::SQUARE_BL:
+            return std::make_unique<BandLimitedWaveGenerator<BandLimitedSquareOscillator, SampleType>>();
+        case WaveType::TRIANGLE_BL:
+            return std::make_unique<BandLimitedWaveGenerator<BandLimitedTriangleOscillator, SampleType>>();
+        case WaveType::SAWTOOTH_BL:
+            return std::make_unique<BandLimitedWaveGenerator<BandLimitedSawtoothOscillator, SampleType>>();
         default:
             return std::make_unique<SineWaveGenerator<SampleType>>();
     }
 }
 
-} // namespace Audio 
\ No newline at end of file
+} // namespace Audio
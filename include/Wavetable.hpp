@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace Audio {
+
+/**
+ * @brief 多级（mipmap）单周期波表
+ * 每个八度一级，第k级只保留前MAX_HARMONICS >> k次谐波，按相位步进选级后最高谐波不超过奈奎斯特频率。
+ * 每级末尾多存一个等于首项的保护采样，线性插值时不需要对索引取模。
+ * 为普通POD：可以在启动时由buildWavetable()填入RAM，也可以在主机上离线生成后作为const对象放在flash。
+ * 一份波表占用 LEVELS × (SIZE + 1) × 2 字节（约16KB），渲染端只读，可被任意多个声部共享
+ */
+struct Wavetable {
+    static constexpr size_t SIZE_BITS = 10;
+    static constexpr size_t SIZE = size_t(1) << SIZE_BITS;
+    static constexpr size_t LEVELS = 8;
+    static constexpr size_t MAX_HARMONICS = SIZE / 8;      // 第0级谐波数：每个最高谐波周期至少8个表项
+    static constexpr uint32_t LEVEL_BASE_BITS = 24;        // 相位步进低于2^24时使用第0级
+
+    using Level = std::array<int16_t, SIZE + 1>;
+
+    std::array<Level, LEVELS> levels{};
+
+    /**
+     * @brief 第level级保留的谐波数
+     */
+    static constexpr size_t harmonics(size_t level) {
+        return MAX_HARMONICS >> level;
+    }
+
+    /**
+     * @brief 按相位步进选择波表级别（每个渲染段调用一次）
+     * 第k级用于 [2^(23+k), 2^(24+k)) 的相位步进，谐波数 × 步进 < 2^31，即不超过奈奎斯特频率
+     * @param phase_step 32位相位步进
+     * @return 波表级别（0..LEVELS-1）
+     */
+    static constexpr size_t levelFor(uint32_t phase_step) {
+        size_t level = 0;
+        while (level + 1 < LEVELS && (phase_step >> (LEVEL_BASE_BITS + level)) != 0) {
+            ++level;
+        }
+        return level;
+    }
+};
+
+/**
+ * @brief 由用户提供的单周期波形生成各级带限波表
+ * 对输入周期做DFT取前MAX_HARMONICS次谐波（去掉直流），逐级截断谐波后重新合成。
+ * 保持输入的幅度；截断谐波产生的过冲超出int16范围时，所有级别统一缩小，级别之间没有音量跳变。
+ * 只在初始化或离线时调用（浮点运算，使用堆上的临时缓冲），不能在渲染端调用
+ * @param cycle 单周期采样（Q15，长度任意，不要求是2的幂）
+ * @param length 采样数（至少4个）
+ * @param table 输出波表
+ * @return 输入为空或过短时返回false，table保持不变
+ */
+bool buildWavetable(const int16_t* cycle, size_t length, Wavetable& table);
+
+} // namespace Audio
@@ -70,6 +70,14 @@ extern "C" {
 // SD卡操作配置
 #define SD_USE_INTERNAL_PULLUP  true        // 使用内部上拉电阻
 
+// =============================================================================
+// MIDI 输入 UART 配置 (DIN-5 经光耦接入)
+// =============================================================================
+
+#define MIDI_UART_INDEX         1           // UART实例 (uart0被stdio占用)
+#define MIDI_PIN_RX             5           // UART1 RX引脚
+#define MIDI_BAUD_RATE          31250       // MIDI 1.0标准波特率
+
 // =============================================================================
 // Joystick 手柄 I2C 配置
 // =============================================================================
@@ -99,7 +107,9 @@ extern "C" {
 
 // 音频生成参数
 #define AUDIO_DEFAULT_VOLUME    80          // 默认音量 (0-100)
+#ifndef AUDIO_MAX_POLYPHONY
 #define AUDIO_MAX_POLYPHONY     4           // 最大同时播放音符数
+#endif
 #define AUDIO_NOTE_DURATION_MS  300         // 默认音符持续时间 (毫秒)
 #define AUDIO_NOTE_GAP_MS       50          // 音符间隔时间 (毫秒)
 
@@ -9,6 +9,13 @@ AudioEventData::AudioEventData(AudioEvent e, const std::string& msg, int32_t val
     : event(e), message(msg), value(val), float_value(fval) {
 }
 
+AudioEventData::AudioEventData(const AudioEventRecord& record)
+    : event(record.event()), value(record.value), code(record.code), timestamp_us(record.timestamp_us) {
+    char text[96];
+    formatEvent(record, text, sizeof(text));
+    message = text;
+}
+
 // ===================== AudioAPI 实现 =====================
 
 AudioAPI::AudioAPI(std::unique_ptr<AudioCore> audio_core)
@@ -20,22 +27,24 @@ AudioAPI::~AudioAPI() {
     if (isPlaying()) {
         stop();
     }
+    // 先停止渲染端（可能运行在core1上），再释放音序器
+    audio_core_.reset();
 }
 
 bool AudioAPI::initialize(const AudioConfig& config) {
     if (!audio_core_) {
-        notifyEvent(AudioEvent::ERROR_OCCURRED, "音频核心未设置");
+        notifyEvent(AudioEventCode::CORE_MISSING);
         return false;
     }
 
     if (!audio_core_->initialize(config)) {
-        notifyEvent(AudioEvent::ERROR_OCCURRED, "音频核心初始化失败");
+        notifyEvent(AudioEventCode::CORE_INIT_FAILED);
         return false;
     }
 
     // 设置音频回调
-    audio_core_->setAudioCallback([this](int16_t* samples, size_t count) {
-        generateAudioSamples(samples, count);
+    audio_core_->setAudioCallback([this](int16_t* samples, size_t frame_count, ChannelLayout layout) {
+        generateAudioSamples(samples, frame_count, layout);
     });
 
     initialized_ = true;
@@ -43,11 +52,10 @@ bool AudioAPI::initialize(const AudioConfig& config) {
 }
 
 bool AudioAPI::playDoReMi(uint32_t note_duration, uint32_t pause_duration, bool loop) {
-    if (!checkInitialized()) return false;
+    if (!beginSequenceStaging()) return false;
 
-    // 创建DO RE MI音阶序列
-    MusicSequence sequence;
-    const std::vector<std::pair<float, std::string>> notes = {
+    // 创建DO RE MI音阶序列（名称驻留一次，之后重复播放不再分配）
+    static constexpr std::pair<float, const char*> NOTES[] = {
         {Notes::C4, "DO (C4)"},
         {Notes::D4, "RE (D4)"},
         {Notes::E4, "MI (E4)"},
@@ -58,69 +66,163 @@ bool AudioAPI::playDoReMi(uint32_t note_duration, uint32_t pause_duration, bool
         {523.25f, "DO (C5)"}
     };
 
-    for (const auto& [freq, name] : notes) {
-        sequence.emplace_back(freq, note_duration, pause_duration, 1.0f, name);
+    staged_events_.clear();
+    for (const auto& [freq, name] : NOTES) {
+        staged_events_.push_back(makeNoteEvent(freq, note_duration, pause_duration, 1.0f,
+                                               NoteNames::intern(name)));
     }
 
-    return playSequence(sequence, loop);
+    return commitStagedSequence(STAGED_EVENTS, loop);
 }
 
 bool AudioAPI::playSequence(const MusicSequence& sequence, bool loop) {
+    if (!beginSequenceStaging()) return false;
+
+    // 在控制端转换为事件，渲染端只做交换，不分配内存
+    staged_events_.clear();
+    for (const auto& note : sequence) {
+        staged_events_.push_back(note.toEvent());
+    }
+    return commitStagedSequence(STAGED_EVENTS, loop);
+}
+
+bool AudioAPI::playSequence(EventSequence events, bool loop) {
+    if (!beginSequenceStaging()) return false;
+
+    staged_view_ = events;
+    return commitStagedSequence(STAGED_VIEW, loop);
+}
+
+bool AudioAPI::playMidiFile(const uint8_t* data, size_t size, bool loop) {
+    if (!beginSequenceStaging()) return false;
+
+    // 只解析文件头并定位音轨，事件在渲染端流式读取
+    if (!staged_midi_.open(data, size)) {
+        notifyEvent(AudioEventCode::MIDI_FILE_INVALID);
+        return false;
+    }
+    return commitStagedSequence(STAGED_MIDI, loop);
+}
+
+bool AudioAPI::playNote(float frequency, uint32_t duration, const std::string& note_name) {
+    if (!beginSequenceStaging()) return false;
+
+    // 完全参考simple_audio_test.cpp：使用200ms暂停时间而不是0
+    uint32_t pause_time = (duration >= 800) ? 200 : (duration / 4);  // 动态计算暂停时间
+    staged_events_.clear();
+    staged_events_.push_back(makeNoteEvent(frequency, duration, pause_time, 1.0f,
+                                           NoteNames::intern(note_name.c_str())));
+    return commitStagedSequence(STAGED_EVENTS, false);
+}
+
+bool AudioAPI::beginSequenceStaging() {
     if (!checkInitialized()) return false;
 
+    // 上一个序列尚未被渲染端取走时不能覆盖暂存区
+    if (staged_sequence_pending_.load(std::memory_order_acquire)) {
+        notifyEvent(AudioEventCode::SEQUENCER_BUSY);
+        return false;
+    }
+
     // 首先停止当前播放（如果有的话）
     stop();
-    
-    sequencer_->setSequence(sequence);
-    sequencer_->setLoop(loop);
-    
+    return true;
+}
+
+bool AudioAPI::commitStagedSequence(SequenceSource source, bool loop) {
+    staged_sequence_pending_.store(true, std::memory_order_release);
+    if (!dispatchCommand({AudioCommandType::SET_SEQUENCE, source})) {
+        staged_sequence_pending_.store(false, std::memory_order_release);
+        return false;
+    }
+
+    // beginSequenceStaging()已停止音频流，以下命令在启动前直接生效，
+    // 渲染端的第一个块即从新序列开头播放
+    if (!dispatchCommand({AudioCommandType::SET_LOOP, loop ? 1u : 0u}) ||
+        !dispatchCommand({AudioCommandType::PLAY, sequence_generation_ + 1})) {
+        return false;
+    }
+    ++sequence_generation_;
+
     if (!audio_core_->start()) {
-        notifyEvent(AudioEvent::ERROR_OCCURRED, "音频输出启动失败");
+        dispatchCommand({AudioCommandType::STOP, 0});
+        notifyEvent(AudioEventCode::STREAM_START_FAILED);
         return false;
     }
 
-    sequencer_->play();
-    loop_enabled_ = loop;
-    
-    notifyEvent(AudioEvent::PLAYBACK_STARTED, "开始播放音符序列");
+    notifyEvent(AudioEventCode::SEQUENCE_STARTED);
     return true;
 }
 
-bool AudioAPI::playNote(float frequency, uint32_t duration, const std::string& note_name) {
+bool AudioAPI::noteOn(uint8_t note, uint8_t velocity) {
     if (!checkInitialized()) return false;
+    if (note > 127 || velocity == 0) return false;
 
-    MusicSequence sequence;
-    // 完全参考simple_audio_test.cpp：使用200ms暂停时间而不是0
-    uint32_t pause_time = (duration >= 800) ? 200 : (duration / 4);  // 动态计算暂停时间
-    sequence.emplace_back(frequency, duration, pause_time, 1.0f, note_name);
-    
-    return playSequence(sequence, false);
+    if (!ensureStreamRunning()) return false;
+    live_stream_ = true;
+
+    note_on_stamp_us_.store(static_cast<uint32_t>(audio_core_->getTimestampUs()), std::memory_order_relaxed);
+    uint32_t value = note | (static_cast<uint32_t>(std::min<uint8_t>(velocity, 127)) << 8);
+    return dispatchCommand({AudioCommandType::NOTE_ON, value});
+}
+
+bool AudioAPI::noteOff(uint8_t note) {
+    if (!checkInitialized()) return false;
+    if (note > 127) return false;
+
+    return dispatchCommand({AudioCommandType::NOTE_OFF, note});
+}
+
+bool AudioAPI::attachMidiInput(MidiInput& input) {
+    for (auto& slot : midi_inputs_) {
+        MidiInput* attached = slot.load(std::memory_order_relaxed);
+        if (attached == &input) {
+            return true;
+        }
+        if (!attached) {
+            slot.store(&input, std::memory_order_release);
+            return true;
+        }
+    }
+    notifyEvent(AudioEventCode::MIDI_INPUT_LIMIT);
+    return false;
+}
+
+uint32_t AudioAPI::getNoteLatencyUs() const {
+    return note_latency_us_.load(std::memory_order_relaxed);
+}
+
+uint32_t AudioAPI::getMaxNoteLatencyUs() const {
+    return note_latency_max_us_.load(std::memory_order_relaxed);
 }
 
 bool AudioAPI::playNoteByIndex(size_t index) {
     if (!checkInitialized()) return false;
 
-    sequencer_->playNote(index);
-    std::string msg = "播放音符索引: " + std::to_string(index);
-    notifyEvent(AudioEvent::NOTE_CHANGED, msg, static_cast<int32_t>(index));
+    if (!dispatchCommand({AudioCommandType::PLAY_INDEX, static_cast<uint32_t>(index)})) {
+        return false;
+    }
+    notifyEvent(AudioEventCode::NOTE_INDEX, static_cast<int32_t>(index));
     return true;
 }
 
 void AudioAPI::pause() {
     if (sequencer_) {
-        sequencer_->pause();
-        notifyEvent(AudioEvent::PLAYBACK_PAUSED, "播放已暂停");
+        dispatchCommand({AudioCommandType::PAUSE, 0});
+        notifyEvent(AudioEventCode::PAUSED);
     }
 }
 
 void AudioAPI::stop() {
-    if (sequencer_) {
-        sequencer_->stop();
-    }
+    // 先停止音频流（返回时渲染端已退出），STOP随即直接生效，返回时播放状态已为STOPPED
     if (audio_core_) {
         audio_core_->stop();
     }
-    notifyEvent(AudioEvent::PLAYBACK_STOPPED, "播放已停止");
+    if (sequencer_) {
+        dispatchCommand({AudioCommandType::STOP, 0});
+    }
+    live_stream_ = false;
+    notifyEvent(AudioEventCode::STOPPED);
 }
 
 void AudioAPI::setVolume(uint8_t volume) {
@@ -128,45 +230,73 @@ void AudioAPI::setVolume(uint8_t volume) {
     uint8_t pico_volume = static_cast<uint8_t>((volume * 255) / 100);
     
     if (audio_core_) {
-        audio_core_->setVolume(pico_volume);
+        dispatchCommand({AudioCommandType::SET_VOLUME, pico_volume});
     }
     
     current_volume_ = volume;
-    notifyEvent(AudioEvent::VOLUME_CHANGED, "音量已设置", volume);
+    notifyEvent(AudioEventCode::VOLUME_CHANGED, volume);
 }
 
 uint8_t AudioAPI::getVolume() const {
     return current_volume_;
 }
 
+void AudioAPI::setPan(float pan) {
+    pan = std::max(-1.0f, std::min(1.0f, pan));
+    int32_t pan_q15 = static_cast<int32_t>(pan * 32767.0f);
+    dispatchCommand({AudioCommandType::SET_PAN, static_cast<uint32_t>(pan_q15)});
+}
+
 void AudioAPI::setWaveType(WaveType wave_type) {
     if (sequencer_) {
-        sequencer_->setWaveType(wave_type);
+        // 各波形的生成器已预先创建，渲染端在块边界处只切换当前生成器
+        if (!dispatchCommand({AudioCommandType::SET_WAVE_TYPE, static_cast<uint32_t>(wave_type)})) {
+            return;
+        }
     }
     current_wave_type_ = wave_type;
-    
-    std::string type_name = waveTypeToString(wave_type);
-    notifyEvent(AudioEvent::NOTE_CHANGED, "波形类型已设置: " + type_name);
+    notifyEvent(AudioEventCode::WAVE_TYPE_CHANGED, static_cast<int32_t>(wave_type));
 }
 
 WaveType AudioAPI::getWaveType() const {
     return current_wave_type_;
 }
 
+bool AudioAPI::setWavetable(const Wavetable* table) {
+    if (!checkInitialized()) return false;
+
+    // 连续设置时渲染端只采用最新的指针
+    staged_wavetable_.store(table, std::memory_order_release);
+    return dispatchCommand({AudioCommandType::SET_WAVETABLE, 0});
+}
+
+bool AudioAPI::setTempoMap(const TempoMap& tempo_map) {
+    if (!checkInitialized()) return false;
+
+    if (staged_tempo_map_pending_.load(std::memory_order_acquire)) {
+        notifyEvent(AudioEventCode::SEQUENCER_BUSY);
+        return false;
+    }
+
+    // 速度表为定长数组，渲染端只做复制
+    staged_tempo_map_ = tempo_map;
+    staged_tempo_map_pending_.store(true, std::memory_order_release);
+    if (!dispatchCommand({AudioCommandType::SET_TEMPO_MAP, 0})) {
+        staged_tempo_map_pending_.store(false, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
 void AudioAPI::setMuted(bool muted) {
-    if (auto* pico_core = static_cast<PicoAudioCore*>(audio_core_.get())) {
-        pico_core->setMuted(muted);
+    if (audio_core_) {
+        audio_core_->setMuted(muted);
     }
-    
-    std::string status = muted ? "静音已开启" : "静音已关闭";
-    notifyEvent(AudioEvent::VOLUME_CHANGED, status, muted ? 0 : current_volume_);
+    notifyEvent(muted ? AudioEventCode::MUTED : AudioEventCode::UNMUTED, muted ? 0 : current_volume_);
 }
 
 bool AudioAPI::isMuted() const {
-    if (auto* pico_core = static_cast<PicoAudioCore*>(audio_core_.get())) {
-        return pico_core->isMuted();
-    }
-    return false;
+    return audio_core_ && audio_core_->isMuted();
 }
 
 void AudioAPI::toggleMute() {
@@ -178,13 +308,53 @@ void AudioAPI::toggleWaveType() {
     setWaveType(new_type);
 }
 
+uint32_t AudioAPI::getUnderrunCount() const {
+    return audio_core_ ? audio_core_->getUnderrunCount() : 0;
+}
+
+uint32_t AudioAPI::getOutputLatencyUs() const {
+    return audio_core_ ? audio_core_->getOutputLatencyUs() : 0;
+}
+
+bool AudioAPI::getStats(AudioStats& stats) const {
+    return audio_core_ && audio_core_->getStats(stats);
+}
+
+void AudioAPI::resetStats() {
+    if (audio_core_) {
+        audio_core_->resetStats();
+    }
+}
+
 bool AudioAPI::isPlaying() const {
-    return audio_core_ && audio_core_->isRunning() && 
-           sequencer_ && sequencer_->getState() == PlaybackState::PLAYING;
+    return audio_core_ && audio_core_->isRunning() &&
+           playback_state_.load(std::memory_order_acquire) == PlaybackState::PLAYING;
 }
 
 PlaybackState AudioAPI::getPlaybackState() const {
-    return sequencer_ ? sequencer_->getState() : PlaybackState::STOPPED;
+    return playback_state_.load(std::memory_order_acquire);
+}
+
+bool AudioAPI::pollEvents(AudioEventRecord& record) {
+    AudioEventRecord control;
+    AudioEventRecord render;
+    bool has_control = control_events_.peek(control);
+    bool has_render = render_events_.peek(render);
+    if (!has_control && !has_render) {
+        return false;
+    }
+
+    // 两个队列按时间戳归并（以差值比较，计数器回绕后仍然正确）
+    bool take_render = has_render &&
+        (!has_control || static_cast<int32_t>(render.timestamp_us - control.timestamp_us) < 0);
+    if (take_render) {
+        return render_events_.pop(record);
+    }
+    return control_events_.pop(record);
+}
+
+uint32_t AudioAPI::getDroppedEventCount() const {
+    return control_events_dropped_ + render_events_dropped_.load(std::memory_order_relaxed);
 }
 
 void AudioAPI::setEventCallback(AudioEventCallback callback) {
@@ -192,46 +362,48 @@ void AudioAPI::setEventCallback(AudioEventCallback callback) {
 }
 
 void AudioAPI::process() {
-    // 对于Pico平台，音频处理通过中断和DMA完成
-    // 这里可以添加额外的处理逻辑，如状态检查等
+    // 轮询式音频核心在此填充缓冲；中断/core1刷新模式下为空操作
     if (audio_core_) {
-        if (auto* pico_core = static_cast<PicoAudioCore*>(audio_core_.get())) {
-            pico_core->processAudio();
-        }
+        audio_core_->process();
     }
     
-    // 检查音频序列是否完成，如果完成且不循环则停止音频核心
-    if (sequencer_ && audio_core_ && audio_core_->isRunning()) {
-        if (sequencer_->isFinished() && !loop_enabled_) {
-            audio_core_->stop();
-            notifyEvent(AudioEvent::PLAYBACK_STOPPED, "序列播放完成");
+    // 音频流停止时收到MIDI输入：重新启动，之后消息由渲染端直接取出
+    if (initialized_ && audio_core_ && !audio_core_->isRunning()) {
+        for (const auto& slot : midi_inputs_) {
+            MidiInput* input = slot.load(std::memory_order_acquire);
+            if (input && input->pending()) {
+                live_stream_ = ensureStreamRunning();
+                break;
+            }
         }
     }
-}
 
-std::map<std::string, float> AudioAPI::getPresetNotes() {
-    return {
-        {"DO", Notes::C4},   {"C4", Notes::C4},
-        {"RE", Notes::D4},   {"D4", Notes::D4},
-        {"MI", Notes::E4},   {"E4", Notes::E4},
-        {"FA", Notes::F4},   {"F4", Notes::F4},
-        {"SOL", Notes::G4},  {"G4", Notes::G4},
-        {"LA", Notes::A4},   {"A4", Notes::A4},
-        {"SI", Notes::B4},   {"B4", Notes::B4},
-        {"DO5", 523.25f},    {"C5", 523.25f}
-    };
+    // 渲染端报告最新一次播放已完成（循环序列不会完成）：停止音频核心（实时演奏时保持运行）
+    uint32_t finished = finished_generation_.load(std::memory_order_acquire);
+    if (finished == sequence_generation_ && finished != finished_generation_seen_ &&
+        audio_core_ && audio_core_->isRunning() && !live_stream_) {
+        finished_generation_seen_ = finished;
+        audio_core_->stop();
+        notifyEvent(AudioEventCode::SEQUENCE_FINISHED);
+    }
+
+    // 在主循环中格式化消息并调用回调
+    if (event_callback_) {
+        AudioEventRecord record;
+        while (pollEvents(record)) {
+            event_callback_(AudioEventData(record));
+        }
+    }
 }
 
 bool AudioAPI::playNoteByName(const std::string& note_name, uint32_t duration) {
-    auto notes = getPresetNotes();
-    auto it = notes.find(note_name);
-    
-    if (it == notes.end()) {
-        notifyEvent(AudioEvent::ERROR_OCCURRED, "未知音符名称: " + note_name);
+    int note = Notes::parseNoteName(note_name);
+    if (note == Notes::INVALID_NOTE) {
+        notifyEvent(AudioEventCode::UNKNOWN_NOTE_NAME);
         return false;
     }
     
-    return playNote(it->second, duration, note_name);
+    return playNote(Notes::frequency(static_cast<uint8_t>(note)), duration, note_name);
 }
 
 void AudioAPI::setupSequencer() {
@@ -240,44 +412,220 @@ void AudioAPI::setupSequencer() {
     }
 }
 
+bool AudioAPI::ensureStreamRunning() {
+    if (audio_core_->isRunning()) return true;
+
+    if (!audio_core_->start()) {
+        notifyEvent(AudioEventCode::STREAM_START_FAILED);
+        return false;
+    }
+    return true;
+}
+
+void AudioAPI::recordNoteLatency() {
+    if (!note_latency_pending_) return;
+    note_latency_pending_ = false;
+
+    uint32_t now = static_cast<uint32_t>(audio_core_->getTimestampUs());
+    uint32_t latency = now - note_on_stamp_us_.load(std::memory_order_relaxed) +
+                       audio_core_->getOutputLatencyUs();
+    note_latency_us_.store(latency, std::memory_order_relaxed);
+    if (latency > note_latency_max_us_.load(std::memory_order_relaxed)) {
+        note_latency_max_us_.store(latency, std::memory_order_relaxed);
+    }
+}
+
 bool AudioAPI::checkInitialized() {
     if (!initialized_) {
-        notifyEvent(AudioEvent::ERROR_OCCURRED, "音频系统未初始化");
+        notifyEvent(AudioEventCode::NOT_INITIALIZED);
         return false;
     }
     return true;
 }
 
-void AudioAPI::generateAudioSamples(int16_t* samples, size_t count) {
+void AudioAPI::generateAudioSamples(int16_t* samples, size_t frame_count, ChannelLayout layout) {
+    // 在块边界处应用控制端发来的命令
+    AudioCommand command;
+    while (command_queue_.pop(command)) {
+        applyCommand(command);
+    }
+    pollMidiInputs();
+    recordNoteLatency();
+
     if (sequencer_) {
         uint32_t sample_rate = audio_core_ ? audio_core_->getConfig().sample_rate : 44100;
-        sequencer_->generateSamples(samples, count, sample_rate);
+        sequencer_->generateSamples(samples, frame_count, layout, sample_rate);
         
-        // 检查是否需要循环播放
-        if (loop_enabled_ && sequencer_->isFinished()) {
-            sequencer_->play();
+        // 循环由音序器自身处理；完成时只发布代号，由主循环停止音频流
+        playback_state_.store(sequencer_->getState(), std::memory_order_release);
+        if (sequencer_->isFinished()) {
+            finished_generation_.store(render_generation_, std::memory_order_release);
+        }
+
+        // 音序器在块内循环回到开头：value为本块内的循环次数
+        uint32_t loop_count = sequencer_->getLoopCount();
+        if (loop_count != loop_count_seen_) {
+            notifyRenderEvent(AudioEventCode::SEQUENCE_LOOPED, static_cast<int32_t>(loop_count - loop_count_seen_));
+            loop_count_seen_ = loop_count;
         }
     } else {
         // 如果没有序列器，填充静音
-        std::fill(samples, samples + count, 0);
+        std::fill(samples, samples + frame_count * channelCount(layout), 0);
     }
 }
 
-void AudioAPI::notifyEvent(AudioEvent event, const std::string& message, int32_t value) {
-    if (event_callback_) {
-        AudioEventData event_data(event, message, value);
-        event_callback_(event_data);
+bool AudioAPI::dispatchCommand(const AudioCommand& command) {
+    if (audio_core_ && audio_core_->isCallbackAsync() && audio_core_->isRunning()) {
+        // 渲染在另一核心上：写入命令队列，永不阻塞
+        if (!command_queue_.push(command)) {
+            notifyEvent(AudioEventCode::COMMAND_QUEUE_FULL);
+            return false;
+        }
+        return true;
+    }
+
+    // 渲染端不会并发执行（同线程、已加锁，或音频流已停止且stop()已等待渲染端退出）：
+    // 先按顺序应用停止前未取走的命令，再直接应用本命令，停止期间队列不会被填满
+    AudioCallbackLock lock(audio_core_.get());
+    AudioCommand pending;
+    while (command_queue_.pop(pending)) {
+        applyCommand(pending);
+    }
+    applyCommand(command);
+    return true;
+}
+
+void AudioAPI::applyCommand(const AudioCommand& command) {
+    switch (command.type) {
+        case AudioCommandType::STOP:
+            sequencer_->stop();
+            break;
+        case AudioCommandType::PAUSE:
+            sequencer_->pause();
+            break;
+        case AudioCommandType::PLAY:
+            sequencer_->play();
+            render_generation_ = command.value;
+            break;
+        case AudioCommandType::PLAY_INDEX:
+            sequencer_->playNote(command.value);
+            break;
+        case AudioCommandType::SET_SEQUENCE:
+            switch (command.value) {
+                case STAGED_VIEW:
+                    sequencer_->setSequence(staged_view_);
+                    break;
+                case STAGED_MIDI:
+                    sequencer_->setMidiFile(staged_midi_);
+                    break;
+                default:
+                    sequencer_->swapSequence(staged_events_);
+                    break;
+            }
+            staged_sequence_pending_.store(false, std::memory_order_release);
+            break;
+        case AudioCommandType::SET_LOOP:
+            sequencer_->setLoop(command.value != 0);
+            break;
+        case AudioCommandType::SET_VOLUME:
+            audio_core_->setVolume(static_cast<uint8_t>(command.value));
+            break;
+        case AudioCommandType::SET_PAN:
+            sequencer_->setPan(static_cast<int32_t>(command.value) / 32767.0f);
+            break;
+        case AudioCommandType::SET_WAVE_TYPE:
+            sequencer_->setWaveType(static_cast<WaveType>(command.value));
+            break;
+        case AudioCommandType::SET_WAVETABLE:
+            sequencer_->setWavetable(staged_wavetable_.load(std::memory_order_acquire));
+            break;
+        case AudioCommandType::SET_TEMPO_MAP:
+            sequencer_->setTempoMap(staged_tempo_map_);
+            staged_tempo_map_pending_.store(false, std::memory_order_release);
+            break;
+        case AudioCommandType::NOTE_ON: {
+            uint8_t note = command.value & 0x7F;
+            uint8_t velocity = (command.value >> 8) & 0x7F;
+            // 适中振幅，与序列播放一致
+            sequencer_->midiNoteOn(note, note, 0.3f * velocity / 127.0f);
+            note_latency_pending_ = true;
+            break;
+        }
+        case AudioCommandType::NOTE_OFF:
+            sequencer_->noteOff(command.value);
+            break;
+    }
+    playback_state_.store(sequencer_->getState(), std::memory_order_release);
+}
+
+void AudioAPI::pollMidiInputs() {
+    if (!sequencer_) return;
+
+    for (const auto& slot : midi_inputs_) {
+        MidiInput* input = slot.load(std::memory_order_acquire);
+        if (!input) continue;
+
+        // 每块最多取出一个队列容量的消息，生产者持续写入时也不会拖长本块
+        MidiMessage message;
+        for (size_t i = 0; i < MidiInput::QUEUE_SIZE && input->pop(message); ++i) {
+            applyMidiMessage(message);
+        }
+    }
+}
+
+void AudioAPI::applyMidiMessage(const MidiMessage& message) {
+    // 打击乐通道（第10通道）没有对应的音色，忽略
+    if (message.channel() == MusicSequencer::MIDI_PERCUSSION_CHANNEL) return;
+
+    // 音符标识：通道 << 8 | 音符号（第1通道与noteOn()/noteOff()的标识相同）
+    uint32_t key = (static_cast<uint32_t>(message.channel()) << 8) | message.data1;
+    switch (message.type()) {
+        case 0x90:
+            if (message.data2 > 0) {
+                sequencer_->midiNoteOn(key, message.data1, 0.3f * message.data2 / 127.0f);
+                // 以字节到达时间为起点测量输入到DAC的延迟
+                note_on_stamp_us_.store(message.timestamp_us, std::memory_order_relaxed);
+                note_latency_pending_ = true;
+                break;
+            }
+            sequencer_->noteOff(key); // 力度为0的Note On等同于Note Off
+            break;
+        case 0x80:
+            sequencer_->noteOff(key);
+            break;
+        case 0xB0:
+            if (message.data1 == 120 || message.data1 == 123) {
+                sequencer_->allNotesOff(); // All Sound Off / All Notes Off
+            }
+            break;
+        case 0xE0:
+            // 声部池只有一个弯音状态，各通道共用
+            sequencer_->setPitchBend(Pitch::fromPitchBend(message.data1, message.data2));
+            break;
+        default:
+            break;
+    }
+}
+
+AudioEventRecord AudioAPI::makeEventRecord(AudioEventCode code, int32_t value) const {
+    AudioEventRecord record;
+    record.timestamp_us = audio_core_ ? static_cast<uint32_t>(audio_core_->getTimestampUs()) : 0;
+    record.value = value;
+    record.code = code;
+    return record;
+}
+
+void AudioAPI::notifyEvent(AudioEventCode code, int32_t value) {
+    if (!control_events_.push(makeEventRecord(code, value))) {
+        ++control_events_dropped_;
     }
 }
 
-std::string AudioAPI::waveTypeToString(WaveType wave_type) const {
-    switch (wave_type) {
-        case WaveType::SINE: return "正弦波";
-        case WaveType::PIANO: return "钢琴音色";
-        case WaveType::SQUARE: return "方波";
-        case WaveType::TRIANGLE: return "三角波";
-        case WaveType::SAWTOOTH: return "锯齿波";
-        default: return "未知";
+void AudioAPI::notifyRenderEvent(AudioEventCode code, int32_t value) {
+    if (!render_events_.push(makeEventRecord(code, value))) {
+        // 单生产者：不需要原子读-改-写
+        render_events_dropped_.store(render_events_dropped_.load(std::memory_order_relaxed) + 1,
+                                     std::memory_order_relaxed);
     }
 }
 
@@ -0,0 +1,79 @@
+#include "AudioEvent.hpp"
+#include "WaveGenerator.hpp"
+#include <cstdio>
+
+namespace Audio {
+
+AudioEvent AudioEventRecord::event() const {
+    switch (code) {
+        case AudioEventCode::SEQUENCE_STARTED:
+        case AudioEventCode::SEQUENCE_LOOPED:
+            return AudioEvent::PLAYBACK_STARTED;
+        case AudioEventCode::SEQUENCE_FINISHED:
+        case AudioEventCode::STOPPED:
+            return AudioEvent::PLAYBACK_STOPPED;
+        case AudioEventCode::PAUSED:
+            return AudioEvent::PLAYBACK_PAUSED;
+        case AudioEventCode::NOTE_INDEX:
+        case AudioEventCode::WAVE_TYPE_CHANGED:
+            return AudioEvent::NOTE_CHANGED;
+        case AudioEventCode::VOLUME_CHANGED:
+        case AudioEventCode::MUTED:
+        case AudioEventCode::UNMUTED:
+            return AudioEvent::VOLUME_CHANGED;
+        default:
+            return AudioEvent::ERROR_OCCURRED;
+    }
+}
+
+const char* waveTypeName(WaveType wave_type) {
+    switch (wave_type) {
+        case WaveType::SINE: return "正弦波";
+        case WaveType::PIANO: return "钢琴音色";
+        case WaveType::SQUARE: return "方波";
+        case WaveType::TRIANGLE: return "三角波";
+        case WaveType::SAWTOOTH: return "锯齿波";
+        case WaveType::SQUARE_BL: return "带限方波";
+        case WaveType::TRIANGLE_BL: return "带限三角波";
+        case WaveType::SAWTOOTH_BL: return "带限锯齿波";
+        case WaveType::WAVETABLE: return "波表";
+        default: return "未知";
+    }
+}
+
+size_t formatEvent(const AudioEventRecord& record, char* buffer, size_t size) {
+    const char* text = "未知事件";
+    int length = 0;
+    switch (record.code) {
+        case AudioEventCode::CORE_MISSING:        text = "音频核心未设置"; break;
+        case AudioEventCode::CORE_INIT_FAILED:    text = "音频核心初始化失败"; break;
+        case AudioEventCode::NOT_INITIALIZED:     text = "音频系统未初始化"; break;
+        case AudioEventCode::SEQUENCER_BUSY:      text = "音序器繁忙，请稍后重试"; break;
+        case AudioEventCode::STREAM_START_FAILED: text = "音频输出启动失败"; break;
+        case AudioEventCode::COMMAND_QUEUE_FULL:  text = "命令队列已满"; break;
+        case AudioEventCode::MIDI_FILE_INVALID:   text = "无法解析MIDI文件"; break;
+        case AudioEventCode::MIDI_INPUT_LIMIT:    text = "MIDI输入端口数已达上限"; break;
+        case AudioEventCode::UNKNOWN_NOTE_NAME:   text = "未知音符名称"; break;
+        case AudioEventCode::SEQUENCE_STARTED:    text = "开始播放音符序列"; break;
+        case AudioEventCode::SEQUENCE_LOOPED:     text = "序列循环播放"; break;
+        case AudioEventCode::SEQUENCE_FINISHED:   text = "序列播放完成"; break;
+        case AudioEventCode::STOPPED:             text = "播放已停止"; break;
+        case AudioEventCode::PAUSED:              text = "播放已暂停"; break;
+        case AudioEventCode::MUTED:               text = "静音已开启"; break;
+        case AudioEventCode::UNMUTED:             text = "静音已关闭"; break;
+        case AudioEventCode::NOTE_INDEX:
+            length = std::snprintf(buffer, size, "播放音符索引: %ld", static_cast<long>(record.value));
+            return length < 0 ? 0 : static_cast<size_t>(length);
+        case AudioEventCode::WAVE_TYPE_CHANGED:
+            length = std::snprintf(buffer, size, "波形类型已设置: %s",
+                                   waveTypeName(static_cast<WaveType>(record.value)));
+            return length < 0 ? 0 : static_cast<size_t>(length);
+        case AudioEventCode::VOLUME_CHANGED:
+            length = std::snprintf(buffer, size, "音量已设置: %ld", static_cast<long>(record.value));
+            return length < 0 ? 0 : static_cast<size_t>(length);
+    }
+    length = std::snprintf(buffer, size, "%s", text);
+    return length < 0 ? 0 : static_cast<size_t>(length);
+}
+
+} // namespace Audio
@@ -0,0 +1,265 @@
+#include "MidiFile.hpp"
+#include <cstring>
+
+namespace Audio {
+
+namespace {
+
+uint32_t readBE(const uint8_t* data, size_t bytes) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+/**
+ * @brief 通道消息的数据字节数
+ */
+size_t channelDataBytes(uint8_t status) {
+    uint8_t type = status & 0xF0;
+    return (type == 0xC0 || type == 0xD0) ? 1 : 2;
+}
+
+} // namespace
+
+// ==================== MidiFile ====================
+
+bool MidiFile::open(const uint8_t* data, size_t size) {
+    track_count_ = 0;
+    if (!data || size < 14 || std::memcmp(data, "MThd", 4) != 0) {
+        return false;
+    }
+
+    uint32_t header_size = readBE(data + 4, 4);
+    if (header_size < 6 || header_size > size - 8) {
+        return false;
+    }
+    format_ = static_cast<uint16_t>(readBE(data + 8, 2));
+    uint16_t declared_tracks = static_cast<uint16_t>(readBE(data + 10, 2));
+    uint16_t division = static_cast<uint16_t>(readBE(data + 12, 2));
+    if (format_ > 1 || (division & 0x8000) || division == 0) {
+        return false; // 不支持type 2和SMPTE时基
+    }
+    ppq_ = division;
+
+    // 依次定位MTrk块，跳过未知块；截断的最后一块按实际长度处理
+    size_t offset = 8 + header_size;
+    while (offset + 8 <= size && track_count_ < MAX_TRACKS && track_count_ < declared_tracks) {
+        const uint8_t* chunk = data + offset;
+        size_t chunk_size = readBE(chunk + 4, 4);
+        size_t available = size - offset - 8;
+        if (chunk_size > available) {
+            chunk_size = available;
+        }
+        if (std::memcmp(chunk, "MTrk", 4) == 0) {
+            tracks_[track_count_].data = chunk + 8;
+            tracks_[track_count_].size = static_cast<uint32_t>(chunk_size);
+            ++track_count_;
+        }
+        offset += 8 + chunk_size;
+    }
+    return track_count_ > 0;
+}
+
+// ==================== MidiTrackCursor ====================
+
+void MidiTrackCursor::reset(const MidiFile::Track& track, uint8_t index) {
+    pos_ = track.data;
+    end_ = track.data + track.size;
+    tick_ = 0;
+    running_status_ = 0;
+    index_ = index;
+    ended_ = false;
+    seekNextEvent();
+}
+
+bool MidiTrackCursor::readVarLen(uint32_t& value) {
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (pos_ >= end_) {
+            return false;
+        }
+        uint8_t byte = *pos_++;
+        value = (value << 7) | (byte & 0x7F);
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MidiTrackCursor::seekNextEvent() {
+    // 读取增量时间；SysEx和不关心的元事件直接跳过，其增量时间计入下一个事件
+    while (true) {
+        uint32_t delta;
+        if (!readVarLen(delta) || pos_ >= end_) {
+            ended_ = true;
+            return;
+        }
+        tick_ += delta;
+
+        uint8_t status = *pos_;
+        uint32_t length;
+        if (status == 0xF0 || status == 0xF7) {
+            ++pos_;
+            if (!readVarLen(length) || length > static_cast<size_t>(end_ - pos_)) {
+                ended_ = true;
+                return;
+            }
+            pos_ += length;
+            continue;
+        }
+        if (status == MidiEvent::META) {
+            if (end_ - pos_ < 2) {
+                ended_ = true;
+                return;
+            }
+            uint8_t type = pos_[1];
+            if (type == MidiEvent::META_TEMPO || type == MidiEvent::META_END_OF_TRACK) {
+                return;
+            }
+            pos_ += 2;
+            if (!readVarLen(length) || length > static_cast<size_t>(end_ - pos_)) {
+                ended_ = true;
+                return;
+            }
+            pos_ += length;
+            continue;
+        }
+        return;
+    }
+}
+
+bool MidiTrackCursor::read(MidiEvent& event) {
+    if (ended_) {
+        return false;
+    }
+
+    event = MidiEvent{};
+    event.tick = tick_;
+    event.track = index_;
+
+    uint8_t status = *pos_;
+    if (status == MidiEvent::META) {
+        uint32_t length;
+        event.status = MidiEvent::META;
+        event.meta_type = pos_[1];
+        pos_ += 2;
+        if (!readVarLen(length) || length > static_cast<size_t>(end_ - pos_)) {
+            ended_ = true;
+            return false;
+        }
+        if (event.meta_type == MidiEvent::META_TEMPO && length >= 3) {
+            event.meta_value = readBE(pos_, 3);
+        }
+        pos_ += length;
+        if (event.meta_type == MidiEvent::META_END_OF_TRACK) {
+            ended_ = true;
+            return true;
+        }
+    } else {
+        if (status & 0x80) {
+            if (status >= 0xF0) {
+                ended_ = true; // 音轨中不应出现的系统消息，视为损坏
+                return false;
+            }
+            running_status_ = status;
+            ++pos_;
+        } else if (!running_status_) {
+            ended_ = true;
+            return false;
+        }
+
+        size_t bytes = channelDataBytes(running_status_);
+        if (static_cast<size_t>(end_ - pos_) < bytes) {
+            ended_ = true;
+            return false;
+        }
+        event.status = running_status_;
+        event.data1 = pos_[0] & 0x7F;
+        event.data2 = bytes > 1 ? (pos_[1] & 0x7F) : 0;
+        pos_ += bytes;
+    }
+
+    seekNextEvent();
+    return true;
+}
+
+// ==================== MidiEventStream ====================
+
+void MidiEventStream::reset(const MidiFile& file) {
+    file_ = file;
+    rewind();
+}
+
+void MidiEventStream::rewind() {
+    heap_size_ = 0;
+    last_tick_ = 0;
+    for (size_t i = 0; i < file_.trackCount(); ++i) {
+        cursors_[i].reset(file_.track(i), static_cast<uint8_t>(i));
+        if (!cursors_[i].atEnd()) {
+            heap_[heap_size_] = static_cast<uint8_t>(i);
+            siftUp(heap_size_++);
+        }
+    }
+}
+
+bool MidiEventStream::next(MidiEvent& event) {
+    while (heap_size_ > 0) {
+        MidiTrackCursor& cursor = cursors_[heap_[0]];
+        bool ok = cursor.read(event);
+
+        // 游标前进后重新调整堆顶；音轨结束则移出堆
+        if (cursor.atEnd()) {
+            heap_[0] = heap_[--heap_size_];
+        }
+        siftDown(0);
+
+        if (ok) {
+            if (event.tick > last_tick_) {
+                last_tick_ = event.tick;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MidiEventStream::earlier(uint8_t a, uint8_t b) const {
+    uint64_t tick_a = cursors_[a].nextTick();
+    uint64_t tick_b = cursors_[b].nextTick();
+    return tick_a < tick_b || (tick_a == tick_b && a < b);
+}
+
+void MidiEventStream::siftDown(size_t index) {
+    while (true) {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < heap_size_ && earlier(heap_[left], heap_[smallest])) smallest = left;
+        if (right < heap_size_ && earlier(heap_[right], heap_[smallest])) smallest = right;
+        if (smallest == index) {
+            return;
+        }
+        uint8_t tmp = heap_[index];
+        heap_[index] = heap_[smallest];
+        heap_[smallest] = tmp;
+        index = smallest;
+    }
+}
+
+void MidiEventStream::siftUp(size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!earlier(heap_[index], heap_[parent])) {
+            return;
+        }
+        uint8_t tmp = heap_[index];
+        heap_[index] = heap_[parent];
+        heap_[parent] = tmp;
+        index = parent;
+    }
+}
+
+} // namespace Audio
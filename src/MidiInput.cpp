@@ -0,0 +1,100 @@
+#include "MidiInput.hpp"
+
+namespace Audio {
+
+namespace {
+
+/**
+ * @brief 通道消息的数据字节数
+ */
+uint8_t channelDataBytes(uint8_t status) {
+    uint8_t type = status & 0xF0;
+    return (type == 0xC0 || type == 0xD0) ? 1 : 2;
+}
+
+/**
+ * @brief 系统公共消息的数据字节数
+ */
+uint8_t systemCommonDataBytes(uint8_t status) {
+    switch (status) {
+        case 0xF1: return 1;    // MTC四分之一帧
+        case 0xF2: return 2;    // 乐曲位置指针
+        case 0xF3: return 1;    // 乐曲选择
+        default: return 0;
+    }
+}
+
+} // namespace
+
+// ==================== MidiStreamParser ====================
+
+bool MidiStreamParser::parse(uint8_t byte, MidiMessage& message) {
+    if (byte >= 0xF8) {
+        return false; // 实时消息：时钟、开始/停止、Active Sensing等
+    }
+
+    if (byte & 0x80) {
+        data_count_ = 0;
+        skip_count_ = 0;
+        in_sysex_ = (byte == 0xF0);
+        if (byte < 0xF0) {
+            running_status_ = byte;
+        } else {
+            // SysEx与系统公共消息取消running status
+            running_status_ = 0;
+            skip_count_ = systemCommonDataBytes(byte);
+        }
+        return false;
+    }
+
+    if (in_sysex_) {
+        return false;
+    }
+    if (skip_count_ > 0) {
+        --skip_count_;
+        return false;
+    }
+    if (!running_status_) {
+        return false; // 没有状态的数据字节（如开机时接在消息中间）
+    }
+
+    data_[data_count_++] = byte;
+    if (data_count_ < channelDataBytes(running_status_)) {
+        return false;
+    }
+
+    message.status = running_status_;
+    message.data1 = data_[0];
+    message.data2 = data_count_ > 1 ? data_[1] : 0;
+    data_count_ = 0;
+    return true;
+}
+
+void MidiStreamParser::reset() {
+    running_status_ = 0;
+    data_count_ = 0;
+    skip_count_ = 0;
+    in_sysex_ = false;
+}
+
+// ==================== MidiInput ====================
+
+void MidiInput::receive(uint8_t byte, uint32_t timestamp_us) {
+    MidiMessage message;
+    if (!parser_.parse(byte, message)) {
+        return;
+    }
+    message.timestamp_us = timestamp_us;
+    if (!queue_.push(message)) {
+        // 单生产者：不需要原子读-改-写（Cortex-M0+没有相应指令）
+        dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+void MidiInput::receive(const uint8_t* data, size_t size, uint32_t timestamp_us) {
+    for (size_t i = 0; i < size; ++i) {
+        receive(data[i], timestamp_us);
+    }
+}
+
+} // namespace Audio
@@ -0,0 +1,55 @@
+#include "MidiPlayer.hpp"
+
+namespace Audio {
+
+void MidiPlayer::setFile(const MidiFile& file, uint32_t sample_rate) {
+    stream_.reset(file);
+    sample_rate_ = sample_rate;
+    restart(0);
+}
+
+void MidiPlayer::restart(uint64_t start_sample) {
+    stream_.rewind();
+    // SMF未指定速度时为120 BPM
+    tempo_ = TempoMap(stream_.file().ppq(), TempoMap::DEFAULT_TEMPO_US);
+    tempo_.prepare(sample_rate_);
+    origin_tick_ = 0;
+    origin_sample_ = start_sample;
+    next();
+}
+
+void MidiPlayer::setSampleRate(uint32_t sample_rate) {
+    if (sample_rate == sample_rate_) {
+        return;
+    }
+    // 以下一个事件为新原点，之后按新采样率换算
+    origin_tick_ = event_.tick;
+    origin_sample_ = event_sample_;
+    sample_rate_ = sample_rate;
+    tempo_.prepare(sample_rate_);
+}
+
+void MidiPlayer::next() {
+    MidiEvent event;
+    while (stream_.next(event)) {
+        if (!event.isMeta()) {
+            event_ = event;
+            event_sample_ = tickToSample(event.tick);
+            has_event_ = true;
+            return;
+        }
+        if (event.meta_type == MidiEvent::META_TEMPO && event.meta_value > 0) {
+            origin_sample_ = tickToSample(event.tick);
+            origin_tick_ = event.tick;
+            tempo_.reset(event.meta_value);
+            tempo_.prepare(sample_rate_);
+        }
+    }
+
+    // 全部音轨结束：以最后一个事件（通常为音轨结束）作为文件结束位置
+    has_event_ = false;
+    event_.tick = stream_.lastTick();
+    event_sample_ = tickToSample(event_.tick);
+}
+
+} // namespace Audio
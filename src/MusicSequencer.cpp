@@ -1,119 +1,160 @@
 #include "MusicSequencer.hpp"
+#include <algorithm>
 
 namespace Audio {
 
-MusicSequencer::MusicSequencer() 
-    : state_(PlaybackState::STOPPED),
-      current_note_index_(0),
-      current_note_samples_(0),
-      note_duration_samples_(0),
-      pause_duration_samples_(0),
-      in_pause_(false),
-      loop_(false),
-      finished_(false) {
-    
-    // 创建默认的正弦波生成器（参考simple_audio_test.cpp）
-    wave_generator_ = WaveFactory<int16_t>::create(WaveType::SINE);
-    
-    // 设置简化ADSR包络（模拟simple_audio_test.cpp的简单音频生成）
+namespace {
+
+/**
+ * @brief 默认简化ADSR包络（模拟simple_audio_test.cpp的简单音频生成）
+ */
+ADSREnvelope defaultEnvelope() {
     ADSREnvelope envelope;
     envelope.attack_samples = 0;          // 无攻击时间，立即达到最大音量
     envelope.decay_samples = 0;           // 无衰减时间
     envelope.sustain_level = 1.0f;        // 维持满音量
     envelope.release_samples = 32000 * 10 / 1000; // 10ms快速释放 @ 32kHz
-    wave_generator_->setEnvelope(envelope);
-    wave_generator_->setAmplitude(0.3f);  // 适中振幅，与simple_audio_test.cpp兼容
+    return envelope;
+}
+
+} // namespace
+
+MusicSequencer::MusicSequencer() 
+    : voices_(WaveType::SINE, defaultEnvelope()),
+      state_(PlaybackState::STOPPED),
+      tempo_map_(TempoMap::milliseconds()),
+      tempo_cursor_(0),
+      sample_rate_(44100),
+      current_note_index_(0),
+      position_samples_(0),
+      note_start_tick_(0),
+      event_tick_(0),
+      event_sample_(0),
+      note_started_(false),
+      in_pause_(false),
+      midi_active_(false),
+      loop_(false),
+      finished_(false),
+      loop_count_(0),
+      pan_gain_left_(32768),
+      pan_gain_right_(32768) {
+    tempo_map_.prepare(sample_rate_);
 }
 
 MusicSequencer::~MusicSequencer() = default;
 
 void MusicSequencer::setSequence(const MusicSequence& sequence) {
-    sequence_ = sequence;
-    current_note_index_ = 0;
-    current_note_samples_ = 0;
-    in_pause_ = false;
-    finished_ = false;
-    
-    if (wave_generator_) {
-        wave_generator_->noteOff();
-        wave_generator_->resetPhase();
+    events_.clear();
+    events_.reserve(sequence.size());
+    for (const auto& note : sequence) {
+        events_.push_back(note.toEvent());
     }
+    setSequence(EventSequence(events_));
 }
 
-void MusicSequencer::addNote(const Note& note) {
-    sequence_.push_back(note);
+void MusicSequencer::setSequence(EventSequence events) {
+    sequence_ = events;
+    midi_active_ = false;
+    rewind(0);
+    
+    voices_.reset();
 }
 
-void MusicSequencer::clearSequence() {
-    sequence_.clear();
-    current_note_index_ = 0;
-    current_note_samples_ = 0;
-    in_pause_ = false;
-    finished_ = false;
+void MusicSequencer::setMidiFile(const MidiFile& file) {
+    sequence_ = EventSequence();
+    midi_active_ = file.isValid();
+    midi_player_.setFile(file, sample_rate_);
+    rewind(0);
     
-    if (wave_generator_) {
-        wave_generator_->noteOff();
-        wave_generator_->resetPhase();
+    voices_.reset();
+}
+
+void MusicSequencer::swapSequence(std::vector<NoteEvent>& events) {
+    events_.swap(events);
+    setSequence(EventSequence(events_));
+}
+
+void MusicSequencer::addNote(const Note& note) {
+    if (sequence_.data() != events_.data()) {
+        events_.assign(sequence_.begin(), sequence_.end());
     }
+    events_.push_back(note.toEvent());
+    sequence_ = EventSequence(events_);
+    midi_active_ = false;
+}
+
+void MusicSequencer::clearSequence() {
+    events_.clear();
+    setSequence(EventSequence());
 }
 
 void MusicSequencer::play() {
-    if (sequence_.empty()) return;
+    if (!hasSource()) return;
     
     state_ = PlaybackState::PLAYING;
-    if (finished_ || current_note_index_ >= sequence_.size()) {
-        current_note_index_ = 0;
-        current_note_samples_ = 0;
-        in_pause_ = false;
-        finished_ = false;
+    if (finished_ || (!midi_active_ && current_note_index_ >= sequence_.size())) {
+        rewind(0);
     }
 }
 
 void MusicSequencer::pause() {
     state_ = PlaybackState::PAUSED;
-    if (wave_generator_) {
-        wave_generator_->noteOff();
-    }
+    voices_.releaseAll();
 }
 
 void MusicSequencer::stop() {
     state_ = PlaybackState::STOPPED;
-    current_note_index_ = 0;
-    current_note_samples_ = 0;
-    in_pause_ = false;
-    finished_ = false;
+    rewind(0);
     
-    if (wave_generator_) {
-        wave_generator_->noteOff();
-        wave_generator_->resetPhase();
-    }
+    voices_.reset();
 }
 
 void MusicSequencer::playNote(size_t index) {
     if (index >= sequence_.size()) return;
     
-    current_note_index_ = index;
-    current_note_samples_ = 0;
-    in_pause_ = false;
-    finished_ = false;
+    rewind(index);
     state_ = PlaybackState::PLAYING;
 }
 
+void MusicSequencer::setTempoMap(const TempoMap& tempo_map) {
+    tempo_map_ = tempo_map;
+    tempo_map_.prepare(sample_rate_);
+    if (!midi_active_ && current_note_index_ < sequence_.size()) {
+        rewind(current_note_index_);
+    }
+}
+
+const TempoMap& MusicSequencer::getTempoMap() const {
+    return tempo_map_;
+}
+
+void MusicSequencer::noteOn(uint32_t key, float frequency, float amplitude) {
+    voices_.noteOn(key, frequency, amplitude);
+}
+
+void MusicSequencer::midiNoteOn(uint32_t key, uint8_t note, float amplitude) {
+    voices_.noteOnMidi(key, note, amplitude);
+}
+
+void MusicSequencer::setPitchBend(int32_t bend) {
+    voices_.setPitchBend(bend);
+}
+
+void MusicSequencer::noteOff(uint32_t key) {
+    voices_.noteOff(key);
+}
+
+void MusicSequencer::allNotesOff() {
+    voices_.releaseAll();
+}
+
 void MusicSequencer::setWaveType(WaveType wave_type) {
-    if (!wave_generator_) return;
-    
-    // 保存当前状态（简化包络设置）
-    ADSREnvelope current_envelope;
-    current_envelope.attack_samples = 0;          // 无攻击时间，立即达到最大音量
-    current_envelope.decay_samples = 0;           // 无衰减时间
-    current_envelope.sustain_level = 1.0f;        // 维持满音量
-    current_envelope.release_samples = 32000 * 10 / 1000; // 10ms快速释放 @ 32kHz
-    float current_amplitude = 0.3f;  // 适中振幅，与simple_audio_test.cpp兼容
-    
-    // 创建新的波形生成器
-    wave_generator_ = WaveFactory<int16_t>::create(wave_type);
-    wave_generator_->setEnvelope(current_envelope);
-    wave_generator_->setAmplitude(current_amplitude);
+    // 各波形的生成器已在声部池中预先创建，这里只切换当前生成器
+    voices_.setWaveType(wave_type);
+}
+
+void MusicSequencer::setWavetable(const Wavetable* table) {
+    voices_.setWavetable(table);
 }
 
 PlaybackState MusicSequencer::getState() const {
@@ -128,29 +169,64 @@ size_t MusicSequencer::getNoteCount() const {
     return sequence_.size();
 }
 
-void MusicSequencer::generateSamples(int16_t* samples, size_t sample_count, uint32_t sample_rate) {
-    if (state_ != PlaybackState::PLAYING || sequence_.empty() || !wave_generator_) {
-        // 填充静音
-        std::fill(samples, samples + sample_count, int16_t(0));
-        return;
+void MusicSequencer::generateSamples(int16_t* samples, size_t frame_count, ChannelLayout layout, uint32_t sample_rate) {
+    if (sample_rate != sample_rate_) {
+        // 采样率变化：重新计算声部的相位步进并预计算速度表，下一个事件按新采样率换算
+        sample_rate_ = sample_rate;
+        voices_.setSampleRate(sample_rate_);
+        tempo_map_.prepare(sample_rate_);
+        scheduleEvent(event_tick_);
+        midi_player_.setSampleRate(sample_rate_);
     }
-    
-    if (wave_generator_) {
-        wave_generator_->setSampleRate(sample_rate);
+
+    if (state_ == PlaybackState::PLAYING && hasSource()) {
+        // 在缓冲前部渲染单声道帧：先处理当前采样处的全部事件，
+        // 再把到下一个事件为止的整段交给声部池，段内没有任何逐采样判断
+        size_t done = 0;
+        while (done < frame_count) {
+            // 同一采样上可能连续发生任意多个事件（如和弦，或零时长音符的开始、结束与下一个音符）；
+            // 只有整个循环序列时长为零时才会在同一采样上回绕两次，此时停止处理以防卡死
+            uint32_t loop_count = loop_count_;
+            while (samplesUntilEvent() == 0 && loop_count_ - loop_count < 2) {
+                updateNoteState();
+            }
+
+            size_t span = std::min<size_t>(frame_count - done, std::max<uint32_t>(samplesUntilEvent(), 1));
+            voices_.render(samples + done, span);
+            position_samples_ += span;
+            done += span;
+        }
+    } else {
+        // 未播放时仍渲染尚在Release的声部，全部结束后输出静音
+        voices_.render(samples, frame_count);
     }
     
-    for (size_t i = 0; i < sample_count; ++i) {
-        // 更新音符状态
-        updateNoteState(sample_rate);
-        
-        // 生成样本
-        if (!finished_ && !in_pause_) {
-            samples[i] = wave_generator_->generateSample();
-        } else {
-            samples[i] = 0;
+    if (layout == ChannelLayout::STEREO) {
+        fanOutStereo(samples, frame_count);
+    }
+}
+
+void MusicSequencer::setPan(float pan) {
+    pan = std::max(-1.0f, std::min(1.0f, pan));
+    // 平衡声像：居中时两声道均为满增益，偏向一侧时衰减另一侧
+    pan_gain_left_ = static_cast<int32_t>((pan > 0.0f ? 1.0f - pan : 1.0f) * 32768.0f);
+    pan_gain_right_ = static_cast<int32_t>((pan < 0.0f ? 1.0f + pan : 1.0f) * 32768.0f);
+}
+
+void MusicSequencer::fanOutStereo(int16_t* samples, size_t frame_count) const {
+    // 从后向前扇出，避免覆盖尚未读取的单声道采样
+    if (pan_gain_left_ == 32768 && pan_gain_right_ == 32768) {
+        for (size_t i = frame_count; i-- > 0;) {
+            int16_t mono = samples[i];
+            samples[2 * i] = mono;
+            samples[2 * i + 1] = mono;
+        }
+    } else {
+        for (size_t i = frame_count; i-- > 0;) {
+            int32_t mono = samples[i];
+            samples[2 * i] = static_cast<int16_t>((mono * pan_gain_left_) >> 15);
+            samples[2 * i + 1] = static_cast<int16_t>((mono * pan_gain_right_) >> 15);
         }
-        
-        current_note_samples_++;
     }
 }
 
@@ -162,78 +238,153 @@ void MusicSequencer::setLoop(bool loop) {
     loop_ = loop;
 }
 
-const Note* MusicSequencer::getCurrentNote() const {
+const NoteEvent* MusicSequencer::getCurrentNote() const {
     if (current_note_index_ < sequence_.size()) {
         return &sequence_[current_note_index_];
     }
     return nullptr;
 }
 
-void MusicSequencer::updateNoteState(uint32_t sample_rate) {
+uint32_t MusicSequencer::samplesUntilEvent() const {
+    if (finished_ || (!midi_active_ && current_note_index_ >= sequence_.size())) {
+        return UINT32_MAX;
+    }
+    uint64_t event_sample = midi_active_ ? midi_player_.eventSample() : event_sample_;
+    if (event_sample <= position_samples_) {
+        return 0;
+    }
+    uint64_t remaining = event_sample - position_samples_;
+    return remaining < UINT32_MAX ? static_cast<uint32_t>(remaining) : UINT32_MAX;
+}
+
+void MusicSequencer::updateNoteState() {
+    if (midi_active_) {
+        updateMidiState();
+        return;
+    }
     if (finished_ || current_note_index_ >= sequence_.size()) {
         return;
     }
     
-    const Note& note = sequence_[current_note_index_];
+    const NoteEvent& note = sequence_[current_note_index_];
     
-    if (!in_pause_) {
-        // 播放音符阶段
-        if (note_duration_samples_ == 0) {
-            // 开始新音符
-            note_duration_samples_ = msToSamples(note.duration_ms, sample_rate);
-            pause_duration_samples_ = msToSamples(note.pause_ms, sample_rate);
-            
-            if (wave_generator_) {
-                wave_generator_->setFrequency(note.frequency);
-                wave_generator_->setAmplitude(0.3f * note.volume);  // 适中振幅，与simple_audio_test.cpp兼容
-                wave_generator_->noteOn();
-            }
-        }
-        
-        if (current_note_samples_ >= note_duration_samples_) {
-            // 音符播放完成，进入暂停阶段
-            if (wave_generator_) {
-                wave_generator_->noteOff();
-            }
-            
-            if (pause_duration_samples_ > 0) {
-                in_pause_ = true;
-                current_note_samples_ = 0;
-            } else {
-                // 没有暂停，直接下一个音符
-                startNextNote(sample_rate);
-            }
-        }
+    if (!note_started_) {
+        // 开始新音符（适中振幅，与simple_audio_test.cpp兼容）
+        note_started_ = true;
+        voices_.noteOn(SEQUENCE_KEY, note.frequency(), 0.3f * note.volume());
+        scheduleEvent(note_start_tick_ + note.duration_ticks);
+    } else if (!in_pause_) {
+        // 音符播放完成，进入暂停阶段（暂停为0时下一个事件就在当前采样）
+        voices_.noteOff(SEQUENCE_KEY);
+        in_pause_ = true;
+        scheduleEvent(note_start_tick_ + note.duration_ticks + note.pause_ticks);
     } else {
-        // 暂停阶段
-        if (current_note_samples_ >= pause_duration_samples_) {
-            startNextNote(sample_rate);
-        }
+        startNextNote();
     }
 }
 
-void MusicSequencer::startNextNote(uint32_t sample_rate) {
+void MusicSequencer::startNextNote() {
+    const NoteEvent& note = sequence_[current_note_index_];
+    note_start_tick_ += note.duration_ticks + note.pause_ticks;
     current_note_index_++;
-    current_note_samples_ = 0;
-    note_duration_samples_ = 0;
-    pause_duration_samples_ = 0;
+    note_started_ = false;
     in_pause_ = false;
     
     if (current_note_index_ >= sequence_.size()) {
         // 序列播放完成
         if (loop_) {
-            // 循环播放
+            // 循环播放（tick继续递增，循环之间不产生舍入漂移）
             current_note_index_ = 0;
+            ++loop_count_;
         } else {
             // 播放完成
             finished_ = true;
             state_ = PlaybackState::STOPPED;
         }
     }
+    scheduleEvent(note_start_tick_);
+}
+
+void MusicSequencer::updateMidiState() {
+    if (finished_) {
+        return;
+    }
+
+    if (!midi_player_.hasEvent()) {
+        // 文件结束：释放残留音符，循环时从当前位置重新开始
+        voices_.releaseAll();
+        if (loop_) {
+            midi_player_.restart(position_samples_);
+            ++loop_count_;
+        } else {
+            finished_ = true;
+            state_ = PlaybackState::STOPPED;
+        }
+        return;
+    }
+
+    const MidiEvent& event = midi_player_.event();
+    // 打击乐通道（第10通道）没有对应的音色，忽略
+    if (event.channel() != MIDI_PERCUSSION_CHANNEL) {
+        uint32_t key = MIDI_FILE_KEY_BASE | (static_cast<uint32_t>(event.channel()) << 8) | event.data1;
+        switch (event.type()) {
+            case 0x90:
+                if (event.data2 > 0) {
+                    // 与实时音符一致的力度映射
+                    voices_.noteOnMidi(key, event.data1, 0.3f * event.data2 / 127.0f);
+                    break;
+                }
+                voices_.noteOff(key); // 力度为0的Note On等同于Note Off
+                break;
+            case 0x80:
+                voices_.noteOff(key);
+                break;
+            case 0xB0:
+                if (event.data1 == 120 || event.data1 == 123) {
+                    voices_.releaseAll(); // All Sound Off / All Notes Off
+                }
+                break;
+            case 0xE0:
+                // 声部池只有一个弯音状态，各通道共用
+                voices_.setPitchBend(Pitch::fromPitchBend(event.data1, event.data2));
+                break;
+            default:
+                break;
+        }
+    }
+    midi_player_.next();
+}
+
+void MusicSequencer::rewind(size_t index) {
+    if (midi_active_) {
+        finished_ = false;
+        position_samples_ = 0;
+        midi_player_.restart(0);
+        voices_.setPitchBend(0);
+        return;
+    }
+
+    if (tempo_map_.preparedSampleRate() != sample_rate_) {
+        tempo_map_.prepare(sample_rate_);
+    }
+
+    note_start_tick_ = 0;
+    for (size_t i = 0; i < index && i < sequence_.size(); ++i) {
+        note_start_tick_ += sequence_[i].duration_ticks + sequence_[i].pause_ticks;
+    }
+    current_note_index_ = index;
+    note_started_ = false;
+    in_pause_ = false;
+    finished_ = false;
+
+    tempo_cursor_ = 0;
+    scheduleEvent(note_start_tick_);
+    position_samples_ = event_sample_;
 }
 
-uint32_t MusicSequencer::msToSamples(uint32_t duration_ms, uint32_t sample_rate) const {
-    return (duration_ms * sample_rate) / 1000;
+void MusicSequencer::scheduleEvent(uint64_t tick) {
+    event_tick_ = tick;
+    event_sample_ = tempo_map_.tickToSample(tick, tempo_cursor_);
 }
 
 } // namespace Audio 
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "NoteEvent.hpp"
+#include <cstring>
+
+namespace Audio {
+
+namespace {
+
+// 驻留名称的字符池与各名称在池中的偏移（ID = 下标 + 1）
+char name_pool[NoteNames::POOL_SIZE];
+uint16_t name_offsets[NoteNames::MAX_NAMES];
+size_t name_count = 0;
+size_t pool_used = 0;
+
+} // namespace
+
+uint16_t NoteNames::intern(const char* name) {
+    if (!name || name[0] == '\0') {
+        return NONE;
+    }
+
+    for (size_t i = 0; i < name_count; ++i) {
+        if (std::strcmp(name_pool + name_offsets[i], name) == 0) {
+            return static_cast<uint16_t>(i + 1);
+        }
+    }
+
+    size_t length = std::strlen(name) + 1;
+    if (name_count >= MAX_NAMES || pool_used + length > POOL_SIZE) {
+        return NONE;
+    }
+
+    std::memcpy(name_pool + pool_used, name, length);
+    name_offsets[name_count] = static_cast<uint16_t>(pool_used);
+    pool_used += length;
+    return static_cast<uint16_t>(++name_count);
+}
+
+const char* NoteNames::lookup(uint16_t id) {
+    if (id == NONE || id > name_count) {
+        return "";
+    }
+    return name_pool + name_offsets[id - 1];
+}
+
+} // namespace Audio
@@ -0,0 +1,220 @@
+#include "OfflineAudioCore.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace Audio {
+
+namespace {
+
+/**
+ * @brief 以小端序写入整数
+ */
+void writeLE(std::FILE* file, uint32_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        std::fputc(static_cast<int>((value >> (8 * i)) & 0xFF), file);
+    }
+}
+
+} // namespace
+
+OfflineAudioCore::~OfflineAudioCore() {
+    closeWavFile();
+}
+
+bool OfflineAudioCore::initialize(const AudioConfig& config) {
+    if (running_) {
+        stop();
+    }
+
+    config_ = config;
+    // 与PicoAudioCore一致：仅支持16位单声道/立体声
+    if (config_.channels != 1) {
+        config_.channels = 2;
+    }
+    config_.bit_depth = 16;
+    if (config_.sample_rate == 0 || config_.buffer_size == 0) {
+        return false;
+    }
+
+    block_.assign(static_cast<size_t>(config_.buffer_size) * config_.channels, 0);
+
+#if AUDIO_ENABLE_STATS
+    stats_.setBlockPeriod(static_cast<uint32_t>(
+        static_cast<uint64_t>(config_.buffer_size) * 1000000 / config_.sample_rate));
+#endif
+    return true;
+}
+
+void OfflineAudioCore::setAudioCallback(AudioCallback callback) {
+    audio_callback_ = callback;
+}
+
+bool OfflineAudioCore::start() {
+    if (running_ || block_.empty() || !audio_callback_) {
+        return false;
+    }
+    running_ = true;
+    return true;
+}
+
+void OfflineAudioCore::stop() {
+    running_ = false;
+}
+
+void OfflineAudioCore::setVolume(uint8_t volume) {
+    volume_ = volume;
+}
+
+uint8_t OfflineAudioCore::getVolume() const {
+    return volume_;
+}
+
+bool OfflineAudioCore::isRunning() const {
+    return running_;
+}
+
+const AudioConfig& OfflineAudioCore::getConfig() const {
+    return config_;
+}
+
+void OfflineAudioCore::setMuted(bool muted) {
+    muted_ = muted;
+}
+
+bool OfflineAudioCore::isMuted() const {
+    return muted_;
+}
+
+void OfflineAudioCore::process() {
+    render(config_.buffer_size);
+}
+
+bool OfflineAudioCore::getStats(AudioStats& stats) const {
+#if AUDIO_ENABLE_STATS
+    stats_.snapshot(stats);
+    return true;
+#else
+    (void)stats;
+    return false;
+#endif
+}
+
+void OfflineAudioCore::resetStats() {
+#if AUDIO_ENABLE_STATS
+    stats_.requestReset();
+#endif
+}
+
+uint64_t OfflineAudioCore::getTimestampUs() const {
+    return config_.sample_rate ? frames_rendered_ * 1000000 / config_.sample_rate : 0;
+}
+
+bool OfflineAudioCore::isCallbackAsync() const {
+    return callback_async_;
+}
+
+void OfflineAudioCore::setCallbackAsync(bool async) {
+    callback_async_ = async;
+}
+
+size_t OfflineAudioCore::render(size_t frame_count) {
+    if (!running_ || !audio_callback_) {
+        return 0;
+    }
+
+    size_t done = 0;
+    while (done < frame_count) {
+        size_t length = std::min<size_t>(frame_count - done, config_.buffer_size);
+        renderBlock(length);
+        done += length;
+    }
+    return done;
+}
+
+void OfflineAudioCore::renderBlock(size_t frame_count) {
+    ChannelLayout layout = (config_.channels == 1) ? ChannelLayout::MONO : ChannelLayout::STEREO;
+    size_t sample_count = frame_count * channelCount(layout);
+
+#if AUDIO_ENABLE_STATS
+    auto start = std::chrono::steady_clock::now();
+#endif
+
+    audio_callback_(block_.data(), frame_count, layout);
+    FixedPoint::applyVolume(block_.data(), sample_count, volume_, muted_);
+
+#if AUDIO_ENABLE_STATS
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    stats_.recordBlock(static_cast<uint32_t>(elapsed.count()));
+#endif
+
+    frames_rendered_ += frame_count;
+
+    if (capture_enabled_) {
+        captured_.insert(captured_.end(), block_.begin(), block_.begin() + sample_count);
+    }
+    if (wav_file_) {
+        for (size_t i = 0; i < sample_count; ++i) {
+            writeLE(wav_file_, static_cast<uint16_t>(block_[i]), 2);
+        }
+        wav_data_bytes_ += static_cast<uint32_t>(sample_count * sizeof(int16_t));
+    }
+}
+
+void OfflineAudioCore::setCaptureEnabled(bool enabled) {
+    capture_enabled_ = enabled;
+}
+
+const std::vector<int16_t>& OfflineAudioCore::getCapturedSamples() const {
+    return captured_;
+}
+
+void OfflineAudioCore::clearCapturedSamples() {
+    captured_.clear();
+}
+
+bool OfflineAudioCore::openWavFile(const std::string& path) {
+    closeWavFile();
+
+    wav_file_ = std::fopen(path.c_str(), "wb");
+    if (!wav_file_) {
+        return false;
+    }
+    wav_data_bytes_ = 0;
+    writeWavHeader(0); // 长度在关闭时回填
+    return true;
+}
+
+void OfflineAudioCore::closeWavFile() {
+    if (!wav_file_) {
+        return;
+    }
+    std::fseek(wav_file_, 0, SEEK_SET);
+    writeWavHeader(wav_data_bytes_);
+    std::fclose(wav_file_);
+    wav_file_ = nullptr;
+}
+
+uint64_t OfflineAudioCore::getFramesRendered() const {
+    return frames_rendered_;
+}
+
+void OfflineAudioCore::writeWavHeader(uint32_t data_bytes) {
+    uint32_t channels = config_.channels;
+    uint32_t block_align = channels * sizeof(int16_t);
+
+    std::fwrite("RIFF", 1, 4, wav_file_);
+    writeLE(wav_file_, 36 + data_bytes, 4);
+    std::fwrite("WAVEfmt ", 1, 8, wav_file_);
+    writeLE(wav_file_, 16, 4);                                  // fmt块长度
+    writeLE(wav_file_, 1, 2);                                   // PCM
+    writeLE(wav_file_, channels, 2);
+    writeLE(wav_file_, config_.sample_rate, 4);
+    writeLE(wav_file_, config_.sample_rate * block_align, 4);   // 字节率
+    writeLE(wav_file_, block_align, 2);
+    writeLE(wav_file_, 16, 2);                                  // 位深度
+    std::fwrite("data", 1, 4, wav_file_);
+    writeLE(wav_file_, data_bytes, 4);
+}
+
+} // namespace Audio
@@ -1,8 +1,13 @@
 #include "PicoAudioCore.hpp"
 #include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
 
 namespace Audio {
 
+PicoAudioCore* PicoAudioCore::active_instance_ = nullptr;
+
 PicoAudioCore::PicoAudioCore(const PicoI2SConfig& i2s_config)
     : i2s_config_(i2s_config), muted_(false) {
 }
@@ -11,6 +16,10 @@ PicoAudioCore::~PicoAudioCore() {
     if (running_) {
         stop();
     }
+    if (core1_launched_) {
+        multicore_reset_core1();
+        active_instance_ = nullptr;
+    }
     cleanupResources();
 }
 
@@ -31,6 +40,24 @@ bool PicoAudioCore::initialize(const AudioConfig& config) {
     // 配置音频格式
     setupAudioFormat();
 
+    // 缓冲数量与初始队列深度（自适应模式从最浅开始，欠载时再加深）
+    buffer_count_ = std::max<uint32_t>(MIN_QUEUE_DEPTH, std::min<uint32_t>(config_.buffer_count, MAX_BUFFER_COUNT));
+    config_.buffer_count = static_cast<uint8_t>(buffer_count_);
+    queue_depth_ = config_.adaptive_latency ? MIN_QUEUE_DEPTH : buffer_count_;
+    comfortable_buffers_ = 0;
+    buffer_period_us_ = static_cast<uint32_t>(
+        static_cast<uint64_t>(config_.buffer_size) * 1000000 / config_.sample_rate);
+
+    // 单次刷新的时间预算，默认为半个缓冲周期
+    refill_budget_us_ = i2s_config_.refill_budget_us;
+    if (refill_budget_us_ == 0) {
+        refill_budget_us_ = buffer_period_us_ / 2;
+    }
+
+#if AUDIO_ENABLE_STATS
+    stats_.setBlockPeriod(buffer_period_us_);
+#endif
+
     // 创建音频缓冲池
     if (!createAudioBufferPool()) {
         return false;
@@ -59,15 +86,24 @@ bool PicoAudioCore::start() {
         return false;
     }
 
+    primed_ = false;
+    running_ = true;
+
+    // 非轮询模式：在启用I2S前挂接中断或唤醒core1，第一个DMA完成中断即开始填充
+    if (i2s_config_.refill_mode != AudioRefillMode::POLLING && !attachRefillIrq()) {
+        running_ = false;
+        return false;
+    }
+
     // 启用I2S输出
     audio_i2s_set_enabled(true);
-    running_ = true;
 
     return true;
 }
 
 void PicoAudioCore::stop() {
     if (running_) {
+        detachRefillIrq();
         audio_i2s_set_enabled(false);
         running_ = false;
     }
@@ -89,30 +125,271 @@ const AudioConfig& PicoAudioCore::getConfig() const {
     return config_;
 }
 
+uint32_t PicoAudioCore::getUnderrunCount() const {
+    return underrun_count_;
+}
+
+uint32_t PicoAudioCore::getOutputLatencyUs() const {
+    return (queue_depth_ - 1) * buffer_period_us_;
+}
+
+uint32_t PicoAudioCore::getQueueDepth() const {
+    return queue_depth_;
+}
+
+bool PicoAudioCore::getStats(AudioStats& stats) const {
+#if AUDIO_ENABLE_STATS
+    stats_.snapshot(stats);
+    return true;
+#else
+    (void)stats;
+    return false;
+#endif
+}
+
+void PicoAudioCore::resetStats() {
+#if AUDIO_ENABLE_STATS
+    stats_.requestReset();
+#endif
+}
+
+uint64_t PicoAudioCore::getTimestampUs() const {
+    return time_us_64();
+}
+
+void PicoAudioCore::lockCallback() {
+    if (i2s_config_.refill_mode == AudioRefillMode::POLLING ||
+        i2s_config_.refill_mode == AudioRefillMode::CORE1) {
+        return; // 轮询模式下回调与主循环同线程；core1模式下由命令队列同步
+    }
+    uint32_t status = save_and_disable_interrupts();
+    if (lock_depth_++ == 0) {
+        saved_irq_status_ = status;
+    }
+}
+
+void PicoAudioCore::unlockCallback() {
+    if (lock_depth_ == 0) {
+        return;
+    }
+    if (--lock_depth_ == 0) {
+        restore_interrupts(saved_irq_status_);
+    }
+}
+
 void PicoAudioCore::processAudio() {
     if (!running_ || !audio_pool_ || !audio_callback_) {
         return;
     }
 
-    // 获取可用的音频缓冲区
-    audio_buffer_t* buffer = take_audio_buffer(audio_pool_, false);
-    if (!buffer) {
-        return; // 没有可用缓冲区
+    // 中断刷新模式下由中断负责填充
+    if (i2s_config_.refill_mode != AudioRefillMode::POLLING) {
+        return;
     }
 
-    // 获取缓冲区样本数据
+    refillBuffers(refill_budget_us_);
+}
+
+void PicoAudioCore::process() {
+    processAudio();
+}
+
+size_t PicoAudioCore::refillBuffers(uint32_t budget_us) {
+    uint32_t start_us = time_us_32();
+    uint32_t max_render_us = 0;
+    size_t filled = 0;
+
+    // 队列加深：取出停放的缓冲直接渲染入队
+    while (parked_count_ > buffer_count_ - queue_depth_) {
+        max_render_us = std::max(max_render_us, renderBuffer(parked_buffers_[--parked_count_]));
+        ++filled;
+    }
+
+    uint32_t rotating = buffer_count_ - parked_count_;
+    uint32_t taken = 0;
+    while (taken < rotating) {
+        audio_buffer_t* buffer = take_audio_buffer(audio_pool_, false);
+        if (!buffer) {
+#if AUDIO_ENABLE_STATS
+            if (taken == 0) {
+                stats_.recordTakeMiss(); // 本次刷新一个缓冲也没取到
+            }
+#endif
+            break; // 没有可用缓冲区
+        }
+        ++taken;
+
+        if (parked_count_ < buffer_count_ - queue_depth_) {
+            // 队列变浅：停放该缓冲，不再参与轮转
+            parked_buffers_[parked_count_++] = buffer;
+            continue;
+        }
+        max_render_us = std::max(max_render_us, renderBuffer(buffer));
+        ++filled;
+
+        if (time_us_32() - start_us >= budget_us) {
+            break; // 超出时间预算，剩余缓冲留给下一次刷新
+        }
+    }
+
+    // 参与轮转的缓冲全部空闲说明DMA已无数据可播放（首次填充除外）
+    bool underrun = primed_ && taken == rotating;
+    if (underrun) {
+        underrun_count_ = underrun_count_ + 1;
+#if AUDIO_ENABLE_STATS
+        stats_.recordUnderrun();
+#endif
+    }
+    if (filled > 0) {
+        primed_ = true;
+        if (config_.adaptive_latency) {
+            adaptQueueDepth(underrun, max_render_us, filled);
+        }
+    }
+    return filled;
+}
+
+void PicoAudioCore::adaptQueueDepth(bool underrun, uint32_t render_us, size_t filled) {
+    if (underrun) {
+        comfortable_buffers_ = 0;
+        if (queue_depth_ < buffer_count_) {
+            queue_depth_ = queue_depth_ + 1; // 下次刷新时取出一个停放的缓冲
+        }
+        return;
+    }
+
+    if (render_us * 100 >= buffer_period_us_ * HEADROOM_PERCENT) {
+        comfortable_buffers_ = 0;
+        return;
+    }
+
+    comfortable_buffers_ += filled;
+    if (comfortable_buffers_ >= SHRINK_AFTER_BUFFERS && queue_depth_ > MIN_QUEUE_DEPTH) {
+        queue_depth_ = queue_depth_ - 1; // 下一个空闲缓冲将被停放
+        comfortable_buffers_ = 0;
+    }
+}
+
+uint32_t PicoAudioCore::renderBuffer(audio_buffer_t* buffer) {
+    uint32_t start_us = time_us_32();
+
+    // 获取缓冲区样本数据（pico-extras中sample_count以帧为单位）
     int16_t* samples = (int16_t*)buffer->buffer->bytes;
-    size_t sample_count = buffer->max_sample_count;
+    size_t frame_count = buffer->max_sample_count;
+    ChannelLayout layout = (config_.channels == 1) ? ChannelLayout::MONO : ChannelLayout::STEREO;
 
     // 调用用户回调生成音频数据
-    audio_callback_(samples, sample_count * config_.channels);
+    audio_callback_(samples, frame_count, layout);
 
     // 应用音量控制
-    applyVolumeControl(samples, sample_count * config_.channels);
+    FixedPoint::applyVolume(samples, frame_count * channelCount(layout), volume_, muted_);
 
-    // 设置实际样本数并返回缓冲区
-    buffer->sample_count = sample_count;
+    // 设置实际帧数并返回缓冲区
+    buffer->sample_count = frame_count;
     give_audio_buffer(audio_pool_, buffer);
+
+    uint32_t render_us = time_us_32() - start_us;
+#if AUDIO_ENABLE_STATS
+    stats_.recordBlock(render_us);
+#endif
+    return render_us;
+}
+
+bool PicoAudioCore::isCallbackAsync() const {
+    return i2s_config_.refill_mode == AudioRefillMode::CORE1;
+}
+
+bool PicoAudioCore::attachRefillIrq() {
+    if (irq_attached_) {
+        return true;
+    }
+
+    if (i2s_config_.refill_mode == AudioRefillMode::CORE1) {
+        if (active_instance_ && active_instance_ != this) {
+            return false; // core1仅能运行一个渲染循环
+        }
+        active_instance_ = this;
+        // core1只启动一次，之后通过render_request_暂停/恢复
+        if (!core1_launched_) {
+            multicore_launch_core1(core1Entry);
+            core1_launched_ = true;
+        }
+        render_request_.fetch_add(1, std::memory_order_release);
+        __sev();
+    } else if (i2s_config_.refill_mode == AudioRefillMode::DMA_IRQ) {
+        if (active_instance_ && active_instance_ != this) {
+            return false; // DMA中断刷新仅支持单实例
+        }
+        active_instance_ = this;
+        // 以最低顺序优先级挂接，保证在pico-extras的I2S处理函数回收缓冲之后执行
+        irq_add_shared_handler(DMA_IRQ_0 + PICO_AUDIO_I2S_DMA_IRQ, dmaIrqHandler,
+                               PICO_SHARED_IRQ_HANDLER_LOWEST_ORDER_PRIORITY);
+    } else {
+        // 以半个缓冲周期为间隔刷新，负延迟表示从回调开始时计时
+        int64_t period_us = static_cast<int64_t>(config_.buffer_size) * 1000000 / config_.sample_rate / 2;
+        if (!add_repeating_timer_us(-period_us, timerRefillCallback, this, &refill_timer_)) {
+            return false;
+        }
+    }
+
+    irq_attached_ = true;
+    return true;
+}
+
+void PicoAudioCore::detachRefillIrq() {
+    if (!irq_attached_) {
+        return;
+    }
+
+    if (i2s_config_.refill_mode == AudioRefillMode::CORE1) {
+        // 唤醒可能在等待空闲缓冲的core1，并等待它确认已停止渲染
+        uint32_t request = render_request_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        __sev();
+        while (render_idle_ack_.load(std::memory_order_acquire) != request) {
+            __wfe();
+        }
+    } else if (i2s_config_.refill_mode == AudioRefillMode::DMA_IRQ) {
+        irq_remove_handler(DMA_IRQ_0 + PICO_AUDIO_I2S_DMA_IRQ, dmaIrqHandler);
+        active_instance_ = nullptr;
+    } else {
+        cancel_repeating_timer(&refill_timer_);
+    }
+    irq_attached_ = false;
+}
+
+void __not_in_flash_func(PicoAudioCore::dmaIrqHandler)() {
+    PicoAudioCore* core = active_instance_;
+    if (core && core->running_ && core->audio_callback_) {
+        core->refillBuffers(core->refill_budget_us_);
+    }
+}
+
+void PicoAudioCore::core1Entry() {
+    PicoAudioCore* core = active_instance_;
+    while (true) {
+        uint32_t request = core->render_request_.load(std::memory_order_acquire);
+        if ((request & 1) == 0) {
+            // 已暂停：确认空闲并唤醒等待中的stop()，之后直到start()前不再访问回调
+            if (core->render_idle_ack_.load(std::memory_order_relaxed) != request) {
+                core->render_idle_ack_.store(request, std::memory_order_release);
+                __sev();
+            }
+            __wfe();
+            continue;
+        }
+        // 没有空闲缓冲时休眠，缓冲归还（DMA中断）或stop()会发出事件唤醒
+        if (core->refillBuffers(core->refill_budget_us_) == 0) {
+            __wfe();
+        }
+    }
+}
+
+bool PicoAudioCore::timerRefillCallback(repeating_timer_t* rt) {
+    auto* core = static_cast<PicoAudioCore*>(rt->user_data);
+    if (core->running_ && core->audio_callback_) {
+        core->refillBuffers(core->refill_budget_us_);
+    }
+    return true;
 }
 
 void PicoAudioCore::setMuted(bool muted) {
@@ -134,6 +411,10 @@ const PicoI2SConfig& PicoAudioCore::getI2SConfig() const {
 void PicoAudioCore::setupAudioFormat() {
     // 配置Pico音频格式
     pico_audio_format_.sample_freq = config_.sample_rate;
+    // 仅支持单声道和立体声
+    if (config_.channels != 1) {
+        config_.channels = 2;
+    }
     pico_audio_format_.channel_count = config_.channels;
     
     // 根据位深度设置格式 (仅支持16位，这是pico-extras库的标准)
@@ -148,7 +429,8 @@ void PicoAudioCore::setupAudioFormat() {
 }
 
 bool PicoAudioCore::createAudioBufferPool() {
-    audio_pool_ = audio_new_producer_pool(&producer_format_, 3, config_.buffer_size);
+    audio_pool_ = audio_new_producer_pool(&producer_format_, buffer_count_, config_.buffer_size);
+    parked_count_ = 0;
     return audio_pool_ != nullptr;
 }
 
@@ -164,24 +446,6 @@ bool PicoAudioCore::initializeI2S() {
     return output_format != nullptr;
 }
 
-void PicoAudioCore::applyVolumeControl(int16_t* samples, size_t count) {
-    if (volume_ == 255) {
-        return; // 最大音量，无需处理
-    }
-
-    if (volume_ == 0 || muted_) {
-        // 静音
-        std::fill(samples, samples + count, 0);
-        return;
-    }
-
-    // 应用音量倍率
-    float volume_factor = static_cast<float>(volume_) / 255.0f;
-    for (size_t i = 0; i < count; ++i) {
-        samples[i] = static_cast<int16_t>(samples[i] * volume_factor);
-    }
-}
-
 void PicoAudioCore::cleanupResources() {
     if (audio_pool_) {
         // 注意：pico-extras音频库可能不提供显式的清理函数
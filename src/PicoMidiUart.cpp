@@ -0,0 +1,71 @@
+#include "PicoMidiUart.hpp"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "pico/time.h"
+
+namespace Audio {
+
+PicoMidiUart* PicoMidiUart::instances_[2] = {nullptr, nullptr};
+
+PicoMidiUart::PicoMidiUart(const PicoMidiUartConfig& config)
+    : config_(config) {
+}
+
+PicoMidiUart::~PicoMidiUart() {
+    end();
+}
+
+bool PicoMidiUart::begin(MidiInput& input) {
+    uint8_t index = config_.uart_index ? 1 : 0;
+    if (instances_[index] && instances_[index] != this) {
+        return false;
+    }
+
+    uart_ = index ? uart1 : uart0;
+    input_ = &input;
+    instances_[index] = this;
+
+    uart_init(uart_, config_.baud_rate);
+    gpio_set_function(config_.rx_pin, GPIO_FUNC_UART);
+    uart_set_fifo_enabled(uart_, true);
+
+    // FIFO达到阈值或接收超时时触发，一次中断读出多个字节
+    uint irq = index ? UART1_IRQ : UART0_IRQ;
+    irq_set_exclusive_handler(irq, index ? uart1Handler : uart0Handler);
+    irq_set_enabled(irq, true);
+    uart_set_irq_enables(uart_, true, false);
+    return true;
+}
+
+void PicoMidiUart::end() {
+    if (!uart_) {
+        return;
+    }
+    uint8_t index = config_.uart_index ? 1 : 0;
+    uart_set_irq_enables(uart_, false, false);
+    irq_set_enabled(index ? UART1_IRQ : UART0_IRQ, false);
+    instances_[index] = nullptr;
+    uart_ = nullptr;
+    input_ = nullptr;
+}
+
+void PicoMidiUart::onReceive() {
+    uint32_t now = time_us_32();
+    while (uart_is_readable(uart_)) {
+        input_->receive(static_cast<uint8_t>(uart_getc(uart_)), now);
+    }
+}
+
+void PicoMidiUart::uart0Handler() {
+    if (instances_[0]) {
+        instances_[0]->onReceive();
+    }
+}
+
+void PicoMidiUart::uart1Handler() {
+    if (instances_[1]) {
+        instances_[1]->onReceive();
+    }
+}
+
+} // namespace Audio
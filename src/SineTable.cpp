@@ -0,0 +1,15 @@
+#include "SineTable.hpp"
+
+#if AUDIO_SINE_TABLE_IN_RAM
+
+namespace Audio {
+namespace SineTable {
+
+// 放入.data段，启动时由运行时从flash复制到SRAM，避免XIP缓存未命中
+__attribute__((section(".data.audio_sine_table")))
+const std::array<int16_t, TABLE_SIZE> q15_ram = Q15;
+
+} // namespace SineTable
+} // namespace Audio
+
+#endif
@@ -0,0 +1,101 @@
+#include "TempoMap.hpp"
+#include <numeric>
+
+namespace Audio {
+
+TempoMap::TempoMap(uint16_t ppq, uint32_t us_per_quarter)
+    : ppq_(ppq ? ppq : DEFAULT_PPQ) {
+    reset(us_per_quarter);
+}
+
+TempoMap TempoMap::milliseconds() {
+    // 1000 tick/四分音符，每四分音符1秒（60 BPM）
+    return TempoMap(1000, 1000000);
+}
+
+bool TempoMap::setTempo(uint64_t tick, uint32_t us_per_quarter) {
+    if (us_per_quarter == 0) {
+        return false;
+    }
+
+    size_t index = 0;
+    while (index < count_ && segments_[index].tick < tick) {
+        ++index;
+    }
+    if (index < count_ && segments_[index].tick == tick) {
+        segments_[index].us_per_quarter = us_per_quarter;
+    } else {
+        if (count_ >= MAX_TEMPO_CHANGES) {
+            return false;
+        }
+        for (size_t i = count_; i > index; --i) {
+            segments_[i] = segments_[i - 1];
+        }
+        segments_[index] = Segment{tick, us_per_quarter, 0, 0, 1};
+        ++count_;
+    }
+
+    // 速度已改变，换算前需重新预计算
+    sample_rate_ = 0;
+    return true;
+}
+
+void TempoMap::reset(uint32_t us_per_quarter) {
+    count_ = 1;
+    segments_[0] = Segment{0, us_per_quarter ? us_per_quarter : DEFAULT_TEMPO_US, 0, 0, 1};
+    sample_rate_ = 0;
+}
+
+void TempoMap::prepare(uint32_t sample_rate) {
+    for (size_t i = 0; i < count_; ++i) {
+        Segment& segment = segments_[i];
+
+        // 每tick采样数 = us_per_quarter * sample_rate / (ppq * 1000000)，约分后保存
+        uint64_t num = static_cast<uint64_t>(segment.us_per_quarter) * sample_rate;
+        uint64_t den = static_cast<uint64_t>(ppq_) * 1000000;
+        uint64_t divisor = std::gcd(num, den);
+        num /= divisor;
+        den /= divisor;
+
+        // 余数乘法 (ticks % den) * num 必须在64位内：极端参数下同时降低分子分母精度
+        while (num > 1 && den > 1 && den > UINT64_MAX / num) {
+            num >>= 1;
+            den >>= 1;
+        }
+        segment.rate_num = num;
+        segment.rate_den = den;
+
+        segment.start_sample = (i == 0) ? 0 :
+            segments_[i - 1].start_sample + ticksToSamples(segments_[i - 1], segment.tick - segments_[i - 1].tick);
+    }
+    sample_rate_ = sample_rate;
+}
+
+uint32_t TempoMap::tempoAt(uint64_t tick) const {
+    return segments_[findSegment(tick, 0)].us_per_quarter;
+}
+
+uint64_t TempoMap::tickToSample(uint64_t tick, size_t& cursor) const {
+    cursor = findSegment(tick, cursor);
+    const Segment& segment = segments_[cursor];
+    return segment.start_sample + ticksToSamples(segment, tick - segment.tick);
+}
+
+size_t TempoMap::findSegment(uint64_t tick, size_t cursor) const {
+    if (cursor >= count_ || segments_[cursor].tick > tick) {
+        cursor = 0;
+    }
+    while (cursor + 1 < count_ && segments_[cursor + 1].tick <= tick) {
+        ++cursor;
+    }
+    return cursor;
+}
+
+uint64_t TempoMap::ticksToSamples(const Segment& segment, uint64_t ticks) {
+    // 拆成整除部分和余数部分，避免 ticks * rate_num 溢出
+    uint64_t whole = ticks / segment.rate_den;
+    uint64_t remainder = ticks % segment.rate_den;
+    return whole * segment.rate_num + remainder * segment.rate_num / segment.rate_den;
+}
+
+} // namespace Audio
@@ -0,0 +1,84 @@
+#include "Wavetable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace Audio {
+
+namespace {
+
+constexpr double TWO_PI = 6.28318530717958647692;
+
+/**
+ * @brief 按级别从高到低（谐波从少到多）累加合成，每合成完一级调用一次visit(level, samples)
+ * 第k级是第k+1级再加上 (harmonics(k+1), harmonics(k)] 次谐波，总计算量等于一次第0级合成。
+ * 第h次谐波在第n点的相位为 h·n mod SIZE，直接查余弦表，没有递推误差
+ */
+template<typename Visit>
+void synthesizeLevels(const std::vector<std::complex<double>>& coefficients,
+                      const std::vector<double>& cosine, Visit&& visit) {
+    constexpr size_t MASK = Wavetable::SIZE - 1;
+    constexpr size_t QUARTER = Wavetable::SIZE / 4;
+    std::vector<double> samples(Wavetable::SIZE, 0.0);
+    size_t added = 0;
+    for (size_t level = Wavetable::LEVELS; level-- > 0;) {
+        size_t limit = std::min(Wavetable::harmonics(level), coefficients.size() - 1);
+        for (size_t h = added + 1; h <= limit; ++h) {
+            // Re(c·e^(iθ)) = Re(c)·cosθ - Im(c)·sinθ，sinθ = cos(θ - π/2)
+            double re = coefficients[h].real();
+            double im = coefficients[h].imag();
+            for (size_t n = 0; n < Wavetable::SIZE; ++n) {
+                size_t index = (h * n) & MASK;
+                samples[n] += re * cosine[index] - im * cosine[(index - QUARTER) & MASK];
+            }
+        }
+        added = std::max(added, limit);
+        visit(level, samples);
+    }
+}
+
+} // namespace
+
+bool buildWavetable(const int16_t* cycle, size_t length, Wavetable& table) {
+    if (cycle == nullptr || length < 4) return false;
+
+    // 单边谱系数 c_h = (2/N)·Σ x[n]·e^(-i·2πhn/N)，谐波数不超过输入的奈奎斯特频率
+    size_t harmonics = std::min(Wavetable::MAX_HARMONICS, (length - 1) / 2);
+    std::vector<std::complex<double>> coefficients(harmonics + 1);
+    for (size_t h = 1; h <= harmonics; ++h) {
+        std::complex<double> rotation = std::polar(1.0, -TWO_PI * h / length);
+        std::complex<double> phasor(1.0);
+        std::complex<double> sum;
+        for (size_t n = 0; n < length; ++n) {
+            sum += static_cast<double>(cycle[n]) * phasor;
+            phasor *= rotation;
+        }
+        coefficients[h] = sum * (2.0 / length);
+    }
+
+    std::vector<double> cosine(Wavetable::SIZE);
+    for (size_t n = 0; n < Wavetable::SIZE; ++n) {
+        cosine[n] = std::cos(TWO_PI * n / Wavetable::SIZE);
+    }
+
+    // 第一遍求所有级别的峰值，第二遍以统一增益量化
+    double peak = 0.0;
+    synthesizeLevels(coefficients, cosine, [&](size_t, const std::vector<double>& samples) {
+        for (double sample : samples) peak = std::max(peak, std::fabs(sample));
+    });
+    double gain = peak > 32767.0 ? 32767.0 / peak : 1.0;
+
+    synthesizeLevels(coefficients, cosine, [&](size_t level, const std::vector<double>& samples) {
+        Wavetable::Level& out = table.levels[level];
+        for (size_t n = 0; n < Wavetable::SIZE; ++n) {
+            double value = std::round(samples[n] * gain);
+            out[n] = static_cast<int16_t>(std::clamp(value, -32767.0, 32767.0));
+        }
+        out[Wavetable::SIZE] = out[0];
+    });
+    return true;
+}
+
+} // namespace Audio
@@ -0,0 +1,1473 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AudioAPI.hpp"
+#include "OfflineAudioCore.hpp"
+#include "VoicePool.hpp"
+#include "MidiFile.hpp"
+#include "MidiInput.hpp"
+#include "SmfBuilder.hpp"
+
+using namespace Audio;
+
+// 统计堆分配次数，用于检查渲染路径不分配内存
+static size_t g_allocations = 0;
+
+void* operator new(size_t size) {
+    ++g_allocations;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+// 替换的operator new使用malloc，与free配对是正确的
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * @brief 黄金音频回归测试
+ * 在主机上渲染一组固定场景（各波形、包络边界情况、DO-RE-MI、复音抢占、波形切换、多级波表、速度变化、MIDI文件与MIDI输入），
+ * 将PCM的FNV-1a哈希与仓库中的黄金文件逐位比较，并附加与实现无关的容差检查
+ * （MIDI解析、事件格式化等不产生音频的检查单独列出，不进入黄金文件）：
+ *   - 块渲染与逐采样渲染必须逐位一致
+ *   - 定点路径相对浮点参考路径的信噪比不低于阈值
+ *   - 整条链路的输出与缓冲大小无关，常量事件表与playDoReMi()输出一致
+ * 有意改变输出的优化在容差检查通过后用 --update 重新生成黄金文件。
+ * 用法：golden_audio_test <黄金文件> [--update]
+ */
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 44100;
+
+// 音符名解析与字面量在编译期求值
+using namespace NoteLiterals;
+static_assert("A4"_note == Notes::MIDI_A4 && "C#4"_note == 61 && "Bb2"_note == 46, "音符名字面量");
+static_assert("A4"_hz == 440.0f && "A5"_hz == 880.0f && "A-1"_hz == 13.75f, "音符频率表");
+static_assert(Notes::phaseStep("A4"_note, 48000) == 39370533u, "相位步进表");
+static_assert(Pitch::frequencyFromPitch(Pitch::fromNote(69)) == 440u << 16, "exp2音高管线");
+static_assert(Notes::parseNoteName("X4") == Notes::INVALID_NOTE, "非法音符名");
+static_assert(Notes::parseNoteName("C-1") == 0 && Notes::parseNoteName("C-0") == Notes::INVALID_NOTE &&
+              Notes::parseNoteName("C-2") == Notes::INVALID_NOTE, "负八度只有-1");
+static_assert(Pitch::stepScale(Pitch::MIN_SAMPLE_RATE - 1) == 0 && Pitch::stepScale(Pitch::MIN_SAMPLE_RATE) == 0xFFF000FFu,
+              "步进比例不溢出32位");
+
+// 设备与主机共用的输出音量增益
+static_assert(FixedPoint::volumeGainQ15(255, false) == FixedPoint::Q15_ONE, "满音量不缩放");
+static_assert(FixedPoint::volumeGainQ15(255, true) == 0 && FixedPoint::volumeGainQ15(0, false) == 0, "静音");
+
+// 块渲染时循环使用的块长度，覆盖1采样、奇数长度和大于混音分块的长度
+constexpr size_t BLOCK_PATTERN[] = {37, 64, 256, 1, 113, 500};
+
+/**
+ * @brief 单个场景的渲染结果
+ */
+struct CaseResult {
+    std::string name;
+    size_t samples = 0;
+    uint64_t hash = 0;
+    double snr_db = NAN;                 // 定点/浮点信噪比（不适用时为NAN）
+    bool audio = true;                   // false为不产生音频的检查项，不与黄金文件比较
+    std::vector<std::string> failures;   // 容差检查失败说明
+};
+
+uint64_t fnv1a(const std::vector<int16_t>& pcm) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int16_t sample : pcm) {
+        uint16_t bits = static_cast<uint16_t>(sample);
+        for (int i = 0; i < 2; ++i) {   // 按小端字节序，与平台无关
+            hash ^= (bits >> (8 * i)) & 0xFF;
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return hash;
+}
+
+/**
+ * @brief 定点输出相对浮点参考的信噪比
+ * @return 信噪比（dB），两者完全一致时返回INFINITY
+ */
+double snrDb(const std::vector<int16_t>& fixed, const std::vector<float>& reference) {
+    double signal = 0.0;
+    double noise = 0.0;
+    for (size_t i = 0; i < fixed.size(); ++i) {
+        double ref = reference[i] * 32767.0;
+        double diff = fixed[i] - ref;
+        signal += ref * ref;
+        noise += diff * diff;
+    }
+    if (noise == 0.0) return INFINITY;
+    if (signal == 0.0) return -INFINITY;
+    return 10.0 * std::log10(signal / noise);
+}
+
+// ==============================================================================
+// 单生成器场景
+// ==============================================================================
+
+/**
+ * @brief 单个生成器的演奏脚本
+ * 在note_off_at处松开，retrigger_at非0时在该处重新按下，共渲染total个采样
+ */
+struct GeneratorScript {
+    const char* name;
+    ADSREnvelope envelope;
+    uint32_t note_off_at;
+    uint32_t retrigger_at;
+    uint32_t total;
+    double min_snr_db;
+};
+
+constexpr ADSREnvelope makeEnvelope(uint32_t attack, uint32_t decay, float sustain, uint32_t release) {
+    ADSREnvelope envelope;
+    envelope.attack_samples = attack;
+    envelope.decay_samples = decay;
+    envelope.sustain_level = sustain;
+    envelope.release_samples = release;
+    return envelope;
+}
+
+constexpr double DEFAULT_MIN_SNR_DB = 60.0;
+
+const GeneratorScript ENVELOPE_SCRIPTS[] = {
+    {"adsr",              makeEnvelope(441, 4410, 0.6f, 2205),  8000,    0, 12000, DEFAULT_MIN_SNR_DB},
+    {"zero_times",        makeEnvelope(0, 0, 1.0f, 0),          3000,    0,  4000, DEFAULT_MIN_SNR_DB},
+    {"sustain_zero",      makeEnvelope(100, 1000, 0.0f, 500),   3000,    0,  4000, DEFAULT_MIN_SNR_DB},
+    {"release_in_attack", makeEnvelope(2000, 1000, 0.5f, 800),   700,    0,  3000, DEFAULT_MIN_SNR_DB},
+    {"release_in_decay",  makeEnvelope(200, 3000, 0.3f, 1000),  1500,    0,  4000, DEFAULT_MIN_SNR_DB},
+    {"one_sample_stages", makeEnvelope(1, 1, 0.5f, 1),          1000,    0,  1500, DEFAULT_MIN_SNR_DB},
+    {"retrigger_release", makeEnvelope(300, 600, 0.7f, 3000),   2000, 3000,  7000, DEFAULT_MIN_SNR_DB},
+};
+
+struct WaveCase {
+    WaveType type;
+    const char* name;
+    float frequency;
+};
+
+constexpr WaveCase WAVE_CASES[] = {
+    {WaveType::SINE, "sine", 440.0f},
+    {WaveType::SQUARE, "square", 261.63f},
+    {WaveType::TRIANGLE, "triangle", 329.63f},
+    {WaveType::SAWTOOTH, "sawtooth", 392.0f},
+    {WaveType::PIANO, "piano", 523.25f},
+    {WaveType::SQUARE_BL, "square_bl", 1318.51f},
+    {WaveType::TRIANGLE_BL, "triangle_bl", 1760.0f},
+    {WaveType::SAWTOOTH_BL, "sawtooth_bl", 2349.32f},
+};
+
+/**
+ * @brief 按脚本驱动一个生成器（WaveGenerator或静态分派的声部）
+ * @tparam RenderFunc void(SampleType* out, size_t count)
+ */
+template<typename SampleType = int16_t, typename Generator, typename RenderFunc>
+std::vector<SampleType> runScript(Generator& generator, const GeneratorScript& script,
+                                  float frequency, RenderFunc renderChunk) {
+    generator.setEnvelope(script.envelope);
+    generator.setSampleRate(SAMPLE_RATE);
+    generator.setFrequency(frequency);
+    generator.setAmplitude(0.8f);
+    generator.resetPhase();
+    generator.noteOn();
+
+    std::vector<SampleType> output(script.total);
+    size_t position = 0;
+    size_t pattern = 0;
+    while (position < script.total) {
+        size_t next_event = script.total;
+        if (position < script.note_off_at) next_event = script.note_off_at;
+        else if (script.retrigger_at && position < script.retrigger_at) next_event = script.retrigger_at;
+
+        size_t length = std::min(BLOCK_PATTERN[pattern++ % std::size(BLOCK_PATTERN)], next_event - position);
+        renderChunk(output.data() + position, length);
+        position += length;
+
+        if (position == script.note_off_at) generator.noteOff();
+        if (script.retrigger_at && position == script.retrigger_at) generator.noteOn();
+    }
+    return output;
+}
+
+CaseResult runGeneratorCase(const WaveCase& wave, const GeneratorScript& script) {
+    CaseResult result;
+    result.name = std::string(wave.name) + "/" + script.name;
+
+    auto block = WaveFactory<int16_t>::create(wave.type);
+    auto per_sample = WaveFactory<int16_t>::create(wave.type);
+    auto reference = WaveFactory<float>::create(wave.type);
+
+    std::vector<int16_t> pcm = runScript(*block, script, wave.frequency,
+        [&](int16_t* out, size_t count) { block->render(out, count); });
+    std::vector<int16_t> pcm_per_sample = runScript(*per_sample, script, wave.frequency,
+        [&](int16_t* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) out[i] = per_sample->generateSample();
+        });
+    std::vector<float> pcm_reference = runScript<float>(*reference, script, wave.frequency,
+        [&](float* out, size_t count) { reference->render(out, count); });
+
+    // 静态分派的声部与虚函数生成器使用同一组定点波形与包络，要求逐位一致
+    WaveVoice<> voice(wave.type);
+    std::vector<int16_t> pcm_static = runScript(voice, script, wave.frequency,
+        [&](int16_t* out, size_t count) { voice.render(out, count); });
+
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+
+    if (pcm != pcm_per_sample) {
+        for (size_t i = 0; i < pcm.size(); ++i) {
+            if (pcm[i] != pcm_per_sample[i]) {
+                char message[96];
+                std::snprintf(message, sizeof(message), "块渲染与逐采样渲染在第%zu个采样处不一致 (%d != %d)",
+                              i, pcm[i], pcm_per_sample[i]);
+                result.failures.push_back(message);
+                break;
+            }
+        }
+    }
+
+    if (pcm != pcm_static) {
+        result.failures.push_back("静态分派声部与虚函数生成器的输出不一致");
+    }
+
+    result.snr_db = snrDb(pcm, pcm_reference);
+    if (result.snr_db < script.min_snr_db) {
+        char message[96];
+        std::snprintf(message, sizeof(message), "定点/浮点信噪比 %.1f dB 低于 %.1f dB",
+                      result.snr_db, script.min_snr_db);
+        result.failures.push_back(message);
+    }
+    return result;
+}
+
+// ==============================================================================
+// 整条链路场景
+// ==============================================================================
+
+// 与playDoReMi(250, 50)相同的常量事件表，用于验证零复制序列播放
+constexpr NoteEvent DOREMI_TABLE[] = {
+    makeNoteEvent(Notes::C4, 250, 50), makeNoteEvent(Notes::D4, 250, 50),
+    makeNoteEvent(Notes::E4, 250, 50), makeNoteEvent(Notes::F4, 250, 50),
+    makeNoteEvent(Notes::G4, 250, 50), makeNoteEvent(Notes::A4, 250, 50),
+    makeNoteEvent(Notes::B4, 250, 50), makeNoteEvent(523.25f, 250, 50),
+};
+
+/**
+ * @brief 离线音频核心上的AudioAPI
+ */
+struct OfflineApi {
+    std::unique_ptr<AudioAPI> api;
+    OfflineAudioCore* core = nullptr;   // 由api持有
+};
+
+/**
+ * @brief 离线场景的音频配置
+ * @param channels 声道数
+ * @param buffer_size 每次回调的帧数
+ */
+AudioConfig offlineConfig(uint8_t channels, uint32_t buffer_size) {
+    AudioConfig config;
+    config.sample_rate = SAMPLE_RATE;
+    config.channels = channels;
+    config.buffer_size = buffer_size;
+    return config;
+}
+
+/**
+ * @brief 创建AudioAPI并在离线音频核心上初始化
+ * @param config 音频配置
+ * @param failures 初始化失败时在此记录原因
+ * @return 初始化失败时api为空
+ */
+OfflineApi makeOfflineApi(const AudioConfig& config, std::vector<std::string>& failures) {
+    auto core = std::make_unique<OfflineAudioCore>();
+    OfflineApi fixture;
+    fixture.core = core.get();
+    fixture.api = std::make_unique<AudioAPI>(std::move(core));
+    if (!fixture.api->initialize(config)) {
+        failures.push_back("离线音频核心初始化失败");
+        fixture.api.reset();
+    }
+    return fixture;
+}
+
+/**
+ * @brief 经AudioAPI → MusicSequencer → 离线音频核心渲染DO-RE-MI
+ * @param buffer_size 每次回调的帧数
+ * @param from_table true时播放常量事件表，否则调用playDoReMi()
+ * @return 交错立体声PCM
+ */
+std::vector<int16_t> renderDoReMi(WaveType type, uint16_t buffer_size, std::vector<std::string>& failures,
+                                  bool from_table = false) {
+    OfflineApi fixture = makeOfflineApi(offlineConfig(2, buffer_size), failures);
+    if (!fixture.api) return {};
+    AudioAPI& api = *fixture.api;
+    OfflineAudioCore* offline = fixture.core;
+
+    offline->setCaptureEnabled(true);
+    api.setVolume(100);
+    api.setWaveType(type);
+    if (from_table) {
+        api.playSequence(EventSequence(DOREMI_TABLE), false);
+    } else {
+        api.playDoReMi(250, 50, false);
+    }
+
+    // 8个音符各300ms，另加释放尾音
+    offline->render(SAMPLE_RATE * 27 / 10);
+    return offline->getCapturedSamples();
+}
+
+CaseResult runDoReMiCase(const WaveCase& wave) {
+    CaseResult result;
+    result.name = std::string("doremi/") + wave.name;
+
+    std::vector<int16_t> pcm = renderDoReMi(wave.type, 256, result.failures);
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+
+    if (pcm.empty()) {
+        return result;
+    } else if (renderDoReMi(wave.type, 61, result.failures) != pcm) {
+        result.failures.push_back("输出随缓冲大小变化（256帧与61帧不一致）");
+    } else if (renderDoReMi(wave.type, 256, result.failures, true) != pcm) {
+        result.failures.push_back("常量事件表的播放结果与playDoReMi不一致");
+    }
+    return result;
+}
+
+/**
+ * @brief 声部数超过容量时的抢占场景
+ */
+CaseResult runVoiceStealCase() {
+    CaseResult result;
+    result.name = "voicepool/steal";
+
+    VoicePool<4> pool(WaveType::TRIANGLE, makeEnvelope(200, 2000, 0.5f, 4000));
+    pool.setSampleRate(SAMPLE_RATE);
+
+    std::vector<int16_t> pcm(SAMPLE_RATE / 2);
+    size_t position = 0;
+    size_t pattern = 0;
+    for (uint32_t key = 0; key < 8; ++key) {
+        pool.noteOn(key, 220.0f * (1.0f + 0.25f * key), 0.3f);
+        if (key % 3 == 2) pool.noteOff(key - 1);
+
+        size_t end = (key + 1) * pcm.size() / 10;
+        while (position < end) {
+            size_t length = std::min(BLOCK_PATTERN[pattern++ % std::size(BLOCK_PATTERN)], end - position);
+            pool.render(pcm.data() + position, length);
+            position += length;
+        }
+    }
+    pool.releaseAll();
+    pool.render(pcm.data() + position, pcm.size() - position);
+
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+    return result;
+}
+
+/**
+ * @brief 音符表场景：编译期音符表、定点音高管线、音符名解析与按MIDI音符号触发的声部
+ * 表中频率与std::pow计算的十二平均律相对误差不超过1e-6；定点相位步进与double公式相差
+ * 不超过5e-6（相对）加4个LSB；exp2音高管线在整个音域（含音分）内误差不超过1e-5；
+ * noteOnMidi()与noteOn(frequency())的输出逐位一致
+ */
+CaseResult runPitchTableCase() {
+    CaseResult result;
+    result.name = "notes/pitch_table";
+
+    for (int note = 0; note < static_cast<int>(Notes::MIDI_NOTE_COUNT); ++note) {
+        double expected = 440.0 * std::pow(2.0, (note - 69) / 12.0);
+        float frequency = Notes::frequency(static_cast<uint8_t>(note));
+        if (std::fabs(frequency - expected) > expected * 1e-6) {
+            char message[64];
+            std::snprintf(message, sizeof(message), "音符%d频率误差过大: %f", note, frequency);
+            result.failures.push_back(message);
+        }
+        for (uint32_t rate : {22050u, 32000u, 44100u, 48000u, 16000u}) {
+            double ideal = (frequency * 4294967296.0) / rate;
+            double step = Notes::phaseStep(static_cast<uint8_t>(note), rate);
+            if (std::fabs(step - ideal) > ideal * 5e-6 + 4.0) {
+                char message[64];
+                std::snprintf(message, sizeof(message), "音符%d在%u Hz下相位步进误差过大", note, rate);
+                result.failures.push_back(message);
+            }
+        }
+    }
+
+    // 每7音分取一个音高，覆盖八度边界与插值段内部
+    for (int32_t cents = 0; cents < 12700; cents += 7) {
+        int32_t pitch = Pitch::fromNote(0, cents);
+        double expected = 440.0 * std::pow(2.0, (pitch / 65536.0 - 69.0) / 12.0);
+        double frequency = Pitch::frequencyFromPitch(pitch) / 65536.0;
+        if (std::fabs(frequency - expected) > expected * 1e-5) {
+            char message[64];
+            std::snprintf(message, sizeof(message), "%d音分的exp2频率误差过大: %f", cents, frequency);
+            result.failures.push_back(message);
+            break;
+        }
+    }
+
+    struct NameCase {
+        const char* name;
+        int note;
+    };
+    constexpr NameCase NAME_CASES[] = {
+        {"C4", 60}, {"c#4", 61}, {"Bb2", 46}, {"A-1", 9}, {"C-1", 0}, {"G9", 127}, {"Cb4", 59},
+        {"B#3", 60}, {"DO", 60}, {"sol5", 79}, {"SI", 71}, {"Fa#3", 54}, {"E##4", 66},
+        {"H4", -1}, {"G#9", -1}, {"Cb-1", -1}, {"C10", -1}, {"C-2", -1}, {"", -1}, {"C4 ", -1}, {"DOb", 59},
+    };
+    for (const auto& name_case : NAME_CASES) {
+        if (Notes::parseNoteName(name_case.name) != name_case.note) {
+            result.failures.push_back(std::string("音符名解析错误: \"") + name_case.name + "\"");
+        }
+    }
+
+    // 半音阶：一组声部用表中的相位步进触发，另一组用频率触发，输出必须逐位一致
+    VoicePool<4> table_pool(WaveType::SAWTOOTH, makeEnvelope(100, 1000, 0.6f, 2000));
+    VoicePool<4> float_pool(WaveType::SAWTOOTH, makeEnvelope(100, 1000, 0.6f, 2000));
+    table_pool.setSampleRate(SAMPLE_RATE);
+    float_pool.setSampleRate(SAMPLE_RATE);
+
+    std::vector<int16_t> pcm(SAMPLE_RATE / 2);
+    std::vector<int16_t> reference(pcm.size());
+    size_t allocations = g_allocations;
+    size_t position = 0;
+    size_t pattern = 0;
+    constexpr size_t STEPS = 25;
+    for (uint8_t note = 48; note < 48 + STEPS; ++note) {
+        table_pool.noteOnMidi(note, note, 0.3f);
+        float_pool.noteOn(note, Notes::frequency(note), 0.3f);
+        if (note >= 50) {
+            table_pool.noteOff(note - 2);
+            float_pool.noteOff(note - 2);
+        }
+
+        size_t end = (note - 47) * pcm.size() / STEPS;
+        while (position < end) {
+            size_t length = std::min(BLOCK_PATTERN[pattern++ % std::size(BLOCK_PATTERN)], end - position);
+            table_pool.render(pcm.data() + position, length);
+            float_pool.render(reference.data() + position, length);
+            position += length;
+        }
+    }
+    if (g_allocations != allocations) {
+        result.failures.push_back("按音符号触发时分配了内存");
+    }
+    if (pcm != reference) {
+        result.failures.push_back("查表相位步进与运行时计算的输出不一致");
+    }
+
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+    return result;
+}
+
+/**
+ * @brief 弯音场景：按MIDI音符号触发的和弦在每个控制块上做颤音，随后弯音到+2半音再回到0
+ * 要求每块刷新音高不分配内存；按频率触发的声部不跟随弯音；弯音回到0后相位步进回到查表值
+ */
+CaseResult runPitchBendCase() {
+    CaseResult result;
+    result.name = "voicepool/pitch_bend";
+
+    constexpr size_t CONTROL_BLOCK = 64;
+    VoicePool<4> pool(WaveType::TRIANGLE, makeEnvelope(200, 2000, 0.7f, 3000));
+    pool.setSampleRate(SAMPLE_RATE);
+    VoicePool<1> bent(WaveType::SINE, makeEnvelope(0, 0, 1.0f, 1));
+    VoicePool<1> straight(WaveType::SINE, makeEnvelope(0, 0, 1.0f, 1));
+    bent.setSampleRate(SAMPLE_RATE);
+    straight.setSampleRate(SAMPLE_RATE);
+
+    std::vector<int16_t> pcm(SAMPLE_RATE / 2);
+    size_t allocations = g_allocations;
+    pool.noteOnMidi(60, 60, 0.25f);
+    pool.noteOnMidi(64, 64, 0.25f);
+    pool.noteOn(1000, 196.0f, 0.25f);     // 按频率触发，不受弯音影响
+
+    for (size_t position = 0; position < pcm.size(); position += CONTROL_BLOCK) {
+        size_t block = position / CONTROL_BLOCK;
+        int32_t bend = 0;
+        if (position < pcm.size() / 2) {
+            // 5.5Hz、±30音分的三角颤音
+            int32_t lfo = static_cast<int32_t>((block * 11) % 128);
+            lfo = lfo < 64 ? lfo - 32 : 96 - lfo;
+            bend = lfo * Pitch::fromNote(0, 30) / 32;
+        } else if (position < pcm.size() * 3 / 4) {
+            bend = 2 * Pitch::SEMITONE;
+        }
+        pool.setPitchBend(bend);
+        size_t length = std::min(CONTROL_BLOCK, pcm.size() - position);
+        pool.render(pcm.data() + position, length);
+    }
+    if (g_allocations != allocations) {
+        result.failures.push_back("刷新音高时分配了内存");
+    }
+
+    // 弯音回到0后重新触发：输出与从未弯音的声部逐位一致
+    std::vector<int16_t> bent_pcm(4096);
+    std::vector<int16_t> straight_pcm(bent_pcm.size());
+    bent.setPitchBend(Pitch::SEMITONE / 3);
+    bent.noteOnMidi(69, 69, 0.5f);
+    bent.render(bent_pcm.data(), 100);
+    bent.noteOff(69);
+    bent.render(bent_pcm.data(), 100);
+    bent.setPitchBend(0);
+    bent.noteOnMidi(69, 69, 0.5f);
+    straight.noteOnMidi(69, 69, 0.5f);
+    bent.render(bent_pcm.data(), bent_pcm.size());
+    straight.render(straight_pcm.data(), straight_pcm.size());
+    if (bent_pcm != straight_pcm) {
+        result.failures.push_back("弯音回到0后输出与未弯音的声部不一致");
+    }
+
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+    return result;
+}
+
+/**
+ * @brief 切换波形场景：和弦按下/释放期间在块边界处切换声部池的波形
+ * 要求切换过程不分配内存、不重新触发或截断声部；
+ * 切换到另一波形再立即切回时，输出与从未切换逐位一致（相位与包络连续）
+ */
+CaseResult runWaveSwitchCase() {
+    CaseResult result;
+    result.name = "voicepool/wave_switch";
+
+    constexpr WaveType SWITCH_ORDER[] = {
+        WaveType::PIANO, WaveType::SAWTOOTH, WaveType::TRIANGLE, WaveType::SQUARE, WaveType::SINE
+    };
+    constexpr size_t LENGTH = 12000;
+    constexpr size_t RELEASE_AT = 6000;
+
+    // mode 0：不切换；1：每块切到钢琴再切回；2：每块按SWITCH_ORDER切换
+    auto render = [&](int mode) {
+        VoicePool<4> pool(WaveType::SINE, makeEnvelope(300, 2000, 0.6f, 4000));
+        pool.setSampleRate(SAMPLE_RATE);
+        std::vector<int16_t> pcm(LENGTH);
+
+        size_t allocations = g_allocations;
+        pool.noteOn(1, Notes::C4, 0.25f);
+        pool.noteOn(2, Notes::E4, 0.25f);
+        pool.noteOn(3, Notes::G4, 0.25f);
+        size_t position = 0;
+        size_t pattern = 0;
+        while (position < pcm.size()) {
+            if (position >= RELEASE_AT && position - RELEASE_AT < BLOCK_PATTERN[0]) {
+                pool.noteOff(2);
+            }
+            size_t active = pool.activeCount();
+            if (mode == 1) {
+                pool.setWaveType(WaveType::PIANO);
+                pool.setWaveType(WaveType::SINE);
+            } else if (mode == 2) {
+                pool.setWaveType(SWITCH_ORDER[pattern % std::size(SWITCH_ORDER)]);
+            }
+            if (pool.activeCount() != active) {
+                result.failures.push_back("切换波形时声部被重新触发或截断");
+                break;
+            }
+
+            size_t length = std::min(BLOCK_PATTERN[pattern++ % std::size(BLOCK_PATTERN)], pcm.size() - position);
+            pool.render(pcm.data() + position, length);
+            position += length;
+        }
+        if (g_allocations != allocations) {
+            result.failures.push_back("切换波形或渲染时分配了内存");
+        }
+        return pcm;
+    };
+
+    std::vector<int16_t> reference = render(0);
+    if (render(1) != reference) {
+        result.failures.push_back("切换后切回的输出与未切换不一致（相位或包络不连续）");
+    }
+    std::vector<int16_t> pcm = render(2);
+
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+    return result;
+}
+
+/**
+ * @brief 波表场景：由用户单周期生成多级波表，声部池以WAVETABLE跨八度演奏琶音
+ * 要求各级超过该级谐波上限的成分低于-85dB（int16量化噪声底约-93dB）；低音正弦经线性插值后相对double参考的
+ * 信噪比不低于80dB且比不插值的正弦表高15dB以上；分块与逐采样渲染逐位一致且不分配内存；
+ * 未设置波表时WAVETABLE与SINE输出一致
+ */
+CaseResult runWavetableCase() {
+    CaseResult result;
+    result.name = "wavetable/saw_arpeggio";
+
+    static Wavetable saw_table;
+    static Wavetable sine_table;
+    std::vector<int16_t> cycle(2048);
+    for (size_t n = 0; n < cycle.size(); ++n) {
+        cycle[n] = static_cast<int16_t>(static_cast<int32_t>(n * 65535 / cycle.size()) - 32767);
+    }
+    if (!buildWavetable(cycle.data(), cycle.size(), saw_table)) {
+        result.failures.push_back("无法由锯齿波周期生成波表");
+    }
+    cycle.resize(256);
+    for (size_t n = 0; n < cycle.size(); ++n) {
+        cycle[n] = static_cast<int16_t>(std::lround(32767.0 * std::sin(2.0 * M_PI * n / cycle.size())));
+    }
+    if (!buildWavetable(cycle.data(), cycle.size(), sine_table)) {
+        result.failures.push_back("无法由正弦周期生成波表");
+    }
+    Wavetable unused;
+    if (buildWavetable(nullptr, 256, unused) || buildWavetable(cycle.data(), 3, unused)) {
+        result.failures.push_back("空输入或过短的周期没有被拒绝");
+    }
+
+    // 各级带限：超过谐波上限的能量相对总能量
+    for (size_t level = 0; level < Wavetable::LEVELS; ++level) {
+        const auto& samples = saw_table.levels[level];
+        double inside = 0.0;
+        double outside = 0.0;
+        for (size_t h = 1; h < Wavetable::SIZE / 2; ++h) {
+            double re = 0.0;
+            double im = 0.0;
+            for (size_t n = 0; n < Wavetable::SIZE; ++n) {
+                double angle = 2.0 * M_PI * ((h * n) % Wavetable::SIZE) / Wavetable::SIZE;
+                re += samples[n] * std::cos(angle);
+                im += samples[n] * std::sin(angle);
+            }
+            (h <= Wavetable::harmonics(level) ? inside : outside) += re * re + im * im;
+        }
+        if (samples[Wavetable::SIZE] != samples[0] || 10.0 * std::log10(outside / inside) > -85.0) {
+            char message[96];
+            std::snprintf(message, sizeof(message), "第%zu级波表超出谐波上限的能量为 %.1f dB",
+                          level, 10.0 * std::log10(outside / inside));
+            result.failures.push_back(message);
+        }
+    }
+
+    // 低音（A1）正弦：插值波表与不插值的正弦表相对double参考的信噪比
+    auto sineSnr = [&](auto& voice) {
+        voice.setEnvelope(makeEnvelope(0, 0, 1.0f, 1));
+        voice.setSampleRate(SAMPLE_RATE);
+        voice.setFrequency(55.0f);
+        voice.setAmplitude(1.0f);
+        voice.noteOn();
+        std::vector<int16_t> pcm(SAMPLE_RATE / 4);
+        voice.render(pcm.data(), pcm.size());
+
+        uint32_t step = Pitch::phaseStep(Pitch::frequencyQ16(55.0f), Pitch::stepScale(SAMPLE_RATE));
+        std::vector<float> reference(pcm.size());
+        for (size_t i = 0; i < pcm.size(); ++i) {
+            uint32_t phase = static_cast<uint32_t>(i * step);
+            reference[i] = static_cast<float>(std::sin(2.0 * M_PI * phase / 4294967296.0));
+        }
+        return snrDb(pcm, reference);
+    };
+    Voice<WavetableOscillator> interpolated;
+    interpolated.oscillator().setTable(&sine_table);
+    Voice<SineOscillator> truncated;
+    result.snr_db = sineSnr(interpolated);
+    double truncated_snr = sineSnr(truncated);
+    if (result.snr_db < 80.0 || result.snr_db < truncated_snr + 15.0) {
+        char message[96];
+        std::snprintf(message, sizeof(message), "插值波表信噪比 %.1f dB（不插值正弦表 %.1f dB）",
+                      result.snr_db, truncated_snr);
+        result.failures.push_back(message);
+    }
+
+    // 跨越全部波表级别的琶音
+    auto render = [&](WaveType type, const Wavetable* table, bool per_sample) {
+        VoicePool<4> pool(type, makeEnvelope(100, 1500, 0.6f, 2000));
+        pool.setSampleRate(SAMPLE_RATE);
+        pool.setWavetable(table);
+        std::vector<int16_t> pcm(SAMPLE_RATE);
+        size_t allocations = g_allocations;
+        size_t position = 0;
+        size_t pattern = 0;
+        for (uint8_t note = 24; note <= 120; note += 8) {
+            pool.noteOnMidi(note, note, 0.3f);
+            pool.noteOff(note - 8);
+            size_t end = (note - 16) * pcm.size() / 112;
+            while (position < end) {
+                size_t length = per_sample ? 1 : BLOCK_PATTERN[pattern++ % std::size(BLOCK_PATTERN)];
+                length = std::min(length, end - position);
+                pool.render(pcm.data() + position, length);
+                position += length;
+            }
+        }
+        pool.releaseAll();
+        pool.render(pcm.data() + position, pcm.size() - position);
+        if (g_allocations != allocations) {
+            result.failures.push_back("波表渲染时分配了内存");
+        }
+        return pcm;
+    };
+    std::vector<int16_t> pcm = render(WaveType::WAVETABLE, &saw_table, false);
+    if (render(WaveType::WAVETABLE, &saw_table, true) != pcm) {
+        result.failures.push_back("波表分块渲染与逐采样渲染不一致");
+    }
+    if (render(WaveType::WAVETABLE, nullptr, false) != render(WaveType::SINE, nullptr, false)) {
+        result.failures.push_back("未设置波表时WAVETABLE与SINE输出不一致");
+    }
+
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+    return result;
+}
+
+/**
+ * @brief 按BLOCK_PATTERN分块渲染音序器输出（单声道）
+ */
+std::vector<int16_t> renderSequencer(MusicSequencer& sequencer, size_t samples) {
+    std::vector<int16_t> pcm(samples);
+    size_t position = 0;
+    size_t pattern = 0;
+    while (position < pcm.size()) {
+        size_t length = std::min(BLOCK_PATTERN[pattern++ % std::size(BLOCK_PATTERN)], pcm.size() - position);
+        sequencer.generateSamples(pcm.data() + position, length, ChannelLayout::MONO, SAMPLE_RATE);
+        position += length;
+    }
+    return pcm;
+}
+
+/**
+ * @brief 速度表场景：480 PPQ，120 BPM起，中途变为90 BPM和150 BPM
+ * 检查tick换算的精确值，并从渲染结果中找出每个音符的起点，
+ * 要求与速度表换算的采样位置逐采样一致
+ */
+CaseResult runTempoCase() {
+    CaseResult result;
+    result.name = "sequencer/tempo_changes";
+
+    TempoMap tempo_map(480);
+    tempo_map.setBpm(1920, 90.0f);
+    tempo_map.setBpm(3840, 150.0f);
+    tempo_map.prepare(SAMPLE_RATE);
+
+    struct Expected {
+        uint64_t tick;
+        uint64_t sample;
+    };
+    constexpr Expected EXPECTED[] = {
+        {1920, 88200},                  // 4拍 @120 BPM = 2秒
+        {2400, 117600},                 // +1拍 @90 BPM
+        {3840, 205800},                 // +4拍 @90 BPM（速度取整为666667微秒）
+        {4320, 223440},                 // +1拍 @150 BPM
+    };
+    for (const auto& expected : EXPECTED) {
+        uint64_t sample = tempo_map.tickToSample(expected.tick);
+        if (sample != expected.sample) {
+            char message[96];
+            std::snprintf(message, sizeof(message), "tick %llu 换算为 %llu，期望 %llu",
+                          static_cast<unsigned long long>(expected.tick),
+                          static_cast<unsigned long long>(sample),
+                          static_cast<unsigned long long>(expected.sample));
+            result.failures.push_back(message);
+        }
+    }
+
+    // 毫秒时基下1小时后的位置（32位 ms*采样率 在约97秒后溢出）
+    TempoMap ms_map = TempoMap::milliseconds();
+    ms_map.prepare(SAMPLE_RATE);
+    if (ms_map.tickToSample(3600000) != 3600ULL * SAMPLE_RATE) {
+        result.failures.push_back("毫秒时基长时间换算错误");
+    }
+
+    // 12个四分音符（发声3/4拍，暂停1/4拍）
+    constexpr size_t NOTE_COUNT = 12;
+    std::vector<NoteEvent> events;
+    for (size_t i = 0; i < NOTE_COUNT; ++i) {
+        events.push_back(makeNoteEvent(Notes::A4 * (1.0f + i / 12.0f), 360, 120));
+    }
+
+    MusicSequencer sequencer;
+    sequencer.setTempoMap(tempo_map);
+    sequencer.swapSequence(events);
+    sequencer.play();
+
+    uint64_t total = tempo_map.tickToSample(NOTE_COUNT * 480) + SAMPLE_RATE / 10;
+    std::vector<int16_t> pcm = renderSequencer(sequencer, total);
+
+    // 零相位正弦、无Attack：起点采样为0，下一个采样开始非0
+    size_t silent = 100;    // 序列开始前视为静音
+    size_t note = 0;
+    for (size_t i = 0; i < pcm.size(); ++i) {
+        if (pcm[i] == 0) {
+            ++silent;
+            continue;
+        }
+        if (silent >= 100 && note < NOTE_COUNT) {
+            uint64_t expected = tempo_map.tickToSample(note * 480);
+            if (i - 1 != expected) {
+                char message[96];
+                std::snprintf(message, sizeof(message), "第%zu个音符起点为 %zu，期望 %llu",
+                              note, i - 1, static_cast<unsigned long long>(expected));
+                result.failures.push_back(message);
+            }
+            ++note;
+        }
+        silent = 0;
+    }
+    if (note != NOTE_COUNT) {
+        result.failures.push_back("未检测到全部音符起点");
+    }
+
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+    return result;
+}
+
+/**
+ * @brief 零时长音符检查（不产生黄金音频）
+ * 连续的零时长、零暂停音符与后续音符的开始都发生在同一采样上，
+ * 输出必须与只播放后续音符逐位一致；全部为零时长的循环序列不能卡死
+ */
+CaseResult runZeroLengthNotesCheck() {
+    CaseResult result;
+    result.name = "sequencer/zero_length_notes";
+    result.audio = false;
+
+    auto render = [](std::vector<NoteEvent> events, bool loop) {
+        MusicSequencer sequencer;
+        sequencer.swapSequence(events);
+        sequencer.setLoop(loop);
+        sequencer.play();
+        return renderSequencer(sequencer, SAMPLE_RATE / 5);
+    };
+
+    std::vector<NoteEvent> chain(8, makeNoteEvent(Notes::C4, 0, 0));
+    chain.push_back(makeNoteEvent(Notes::A4, 100, 20));
+    if (render(chain, false) != render({makeNoteEvent(Notes::A4, 100, 20)}, false)) {
+        result.failures.push_back("零时长音符之后的音符未在同一采样开始");
+    }
+
+    std::vector<NoteEvent> silent(3, makeNoteEvent(Notes::C4, 0, 0));
+    render(silent, true);
+    return result;
+}
+
+/**
+ * @brief MIDI文件场景：type 1，96 PPQ，第4拍处速度由120 BPM变为150 BPM
+ * 旋律轨每拍一个音符，和弦轨在第0、4拍与旋律同时发声，打击乐轨在半拍处发声（应被忽略）；
+ * 文件中含running status、SysEx和音轨名。要求每个音符起点与速度换算的采样位置逐采样一致，
+ * 且文件结束后音序器停止
+ */
+CaseResult runMidiFileCase() {
+    CaseResult result;
+    result.name = "midi/type1";
+
+    constexpr uint16_t PPQ = 96;
+    constexpr size_t BEATS = 8;
+    static const uint8_t SYSEX[] = {0x7E, 0x7F, 0x09, 0x01, 0xF7};
+
+    SmfBuilder smf(PPQ);
+    smf.beginTrack();                           // 速度轨
+    smf.tempo(0, 500000);
+    smf.tempo(PPQ * 4, 400000);
+    smf.endOfTrack(PPQ * 4);
+
+    smf.beginTrack();                           // 旋律（通道0，四分之一拍发声）
+    smf.trackName(0, "melody");
+    smf.sysex(0, SYSEX, sizeof(SYSEX));
+    for (size_t beat = 0; beat < BEATS; ++beat) {
+        uint8_t note = static_cast<uint8_t>(60 + beat);
+        smf.noteOn(beat == 0 ? 0 : PPQ * 3 / 4, 0, note, 100);
+        smf.noteOff(PPQ / 4, 0, note);
+    }
+    smf.endOfTrack(0);
+
+    smf.beginTrack();                           // 和弦（通道1，与第0、4拍同时）
+    for (uint8_t beat : {0, 4}) {
+        smf.noteOn(beat == 0 ? 0 : PPQ * 15 / 4, 1, 64, 80);
+        smf.noteOn(0, 1, 67, 80);
+        smf.noteOff(PPQ / 4, 1, 64);
+        smf.noteOff(0, 1, 67);
+    }
+    smf.endOfTrack(0);
+
+    smf.beginTrack();                           // 打击乐（通道10）
+    for (size_t beat = 0; beat < BEATS; ++beat) {
+        smf.noteOn(beat == 0 ? PPQ / 2 : PPQ * 7 / 8, 9, 36, 127);
+        smf.noteOff(PPQ / 8, 9, 36);
+    }
+    smf.endOfTrack(0);
+
+    std::vector<uint8_t> image = smf.build();
+    MidiFile file;
+    if (!file.open(image.data(), image.size()) || file.trackCount() != 4 || file.format() != 1) {
+        result.failures.push_back("MIDI文件头解析错误");
+        return result;
+    }
+
+    constexpr uint64_t EXPECTED[BEATS] = {
+        0, 22050, 44100, 66150,                 // 120 BPM，每拍22050采样
+        88200, 105840, 123480, 141120           // 150 BPM，每拍17640采样
+    };
+
+    MusicSequencer sequencer;
+    sequencer.setMidiFile(file);
+    sequencer.play();
+    std::vector<int16_t> pcm = renderSequencer(sequencer, EXPECTED[BEATS - 1] + 17640 + SAMPLE_RATE / 10);
+
+    // 零相位正弦、无Attack：起点采样为0，下一个采样开始非0
+    size_t silent = 100;
+    size_t note = 0;
+    for (size_t i = 0; i < pcm.size(); ++i) {
+        if (pcm[i] == 0) {
+            ++silent;
+            continue;
+        }
+        if (silent >= 100) {
+            if (note >= BEATS || i - 1 != EXPECTED[note]) {
+                char message[96];
+                std::snprintf(message, sizeof(message), "第%zu个音符起点为 %zu，期望 %llu", note, i - 1,
+                              note < BEATS ? static_cast<unsigned long long>(EXPECTED[note]) : 0ULL);
+                result.failures.push_back(message);
+            }
+            ++note;
+        }
+        silent = 0;
+    }
+    if (note != BEATS) {
+        result.failures.push_back("检测到的音符起点数量不正确");
+    }
+    if (!sequencer.isFinished()) {
+        result.failures.push_back("文件结束后音序器未停止");
+    }
+
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+    return result;
+}
+
+/**
+ * @brief 音符名字面量的运行期检查（不产生音频）
+ * 非法音符名在常量表达式中无法编译；在运行期得到超出MIDI范围的音符号和0Hz，而不是音符0
+ */
+CaseResult runNoteLiteralCheck() {
+    CaseResult result;
+    result.name = "notes/literals";
+    result.audio = false;
+
+    // volatile阻止编译器把调用当作常量折叠
+    volatile size_t length = 2;
+    uint8_t valid = operator""_note("A4", length);
+    uint8_t invalid = operator""_note("H4", length);
+    if (valid != Notes::MIDI_A4 || operator""_hz("A4", length) != 440.0f) {
+        result.failures.push_back("运行期音符名解析错误");
+    }
+    if (invalid != Notes::INVALID_NOTE_LITERAL || operator""_hz("H4", length) != 0.0f) {
+        result.failures.push_back("运行期非法音符名得到了可发声的音符");
+    }
+    return result;
+}
+
+/**
+ * @brief MIDI字节流解析检查（不产生音频）
+ * running status、SysEx、系统公共消息和穿插的实时消息；消息时间戳为最后一个字节的到达时间
+ */
+CaseResult runMidiParserCheck() {
+    CaseResult result;
+    result.name = "midi/parser";
+    result.audio = false;
+
+    static const uint8_t STREAM[] = {
+        0x90, 60, 100,                          // Note On
+        61, 90,                                 // running status
+        0xF8,                                   // 时钟（忽略）
+        0xF0, 0x7E, 0x7F, 0x09, 0x01, 0xF7,     // SysEx（跳过，并取消running status）
+        62, 80,                                 // 无状态字节（忽略）
+        0x90, 0xF8, 62, 0xFE, 80,               // 消息中穿插实时消息
+        0xF2, 0x10, 0x20,                       // 乐曲位置指针（跳过）
+        63, 70,                                 // 无状态字节（忽略）
+        0xC0, 5, 6,                             // 单数据字节消息的running status
+        0x80, 60, 0,                            // Note Off
+        0x90, 61, 0                             // 力度为0的Note On
+    };
+    constexpr MidiMessage EXPECTED[] = {
+        {2, 0x90, 60, 100}, {4, 0x90, 61, 90}, {18, 0x90, 62, 80},
+        {25, 0xC0, 5, 0}, {26, 0xC0, 6, 0}, {29, 0x80, 60, 0}, {32, 0x90, 61, 0},
+    };
+
+    // 以字节序号作为时间戳：消息时间戳应为其最后一个字节的序号
+    MidiInput input;
+    for (size_t i = 0; i < std::size(STREAM); ++i) {
+        input.receive(STREAM[i], static_cast<uint32_t>(i));
+    }
+    MidiMessage message;
+    size_t count = 0;
+    while (input.pop(message)) {
+        if (count >= std::size(EXPECTED) || message.status != EXPECTED[count].status ||
+            message.data1 != EXPECTED[count].data1 || message.data2 != EXPECTED[count].data2 ||
+            message.timestamp_us != EXPECTED[count].timestamp_us) {
+            char text[96];
+            std::snprintf(text, sizeof(text), "第%zu条消息解析错误: %02x %u %u", count,
+                          message.status, message.data1, message.data2);
+            result.failures.push_back(text);
+        }
+        ++count;
+    }
+    if (count != std::size(EXPECTED)) {
+        result.failures.push_back("解析出的消息数量不正确");
+    }
+    return result;
+}
+
+/**
+ * @brief MIDI输入场景：以字节流代替真实控制器
+ * 经AudioAPI → 离线音频核心演奏：音频流由process()在收到消息后启动，
+ * 音符在下一个块边界发声，输入到DAC的延迟从字节到达时间算起；
+ * 音符按通道区分，打击乐通道被忽略
+ */
+CaseResult runMidiInputCase() {
+    CaseResult result;
+    result.name = "midi/input_stream";
+
+    // 演奏：A4，之后以running status加入C5，最后All Notes Off
+    constexpr uint16_t BLOCK = 128;
+    OfflineApi fixture = makeOfflineApi(offlineConfig(2, BLOCK), result.failures);
+    if (!fixture.api) return result;
+    AudioAPI& api = *fixture.api;
+    OfflineAudioCore* offline = fixture.core;
+    offline->setCaptureEnabled(true);
+    api.setVolume(100);
+    api.setWaveType(WaveType::SINE);
+
+    MidiInput input;
+    api.attachMidiInput(input);
+
+    static const uint8_t NOTE_ON[] = {0x90, 69, 100};
+    input.receive(NOTE_ON, sizeof(NOTE_ON), 0);
+    api.process();                              // 收到消息后启动音频流
+    if (!offline->isRunning()) {
+        result.failures.push_back("收到MIDI消息后音频流未启动");
+        return result;
+    }
+    offline->render(BLOCK * 4);
+
+    // 字节在块开始前1ms到达
+    static const uint8_t SECOND[] = {72, 100};
+    input.receive(SECOND, sizeof(SECOND), static_cast<uint32_t>(offline->getTimestampUs()) - 1000);
+    offline->render(BLOCK);
+    uint32_t expected_latency = 1000 + api.getOutputLatencyUs();
+    if (api.getNoteLatencyUs() != expected_latency) {
+        char text[96];
+        std::snprintf(text, sizeof(text), "输入延迟为 %lu us，期望 %lu us",
+                      static_cast<unsigned long>(api.getNoteLatencyUs()),
+                      static_cast<unsigned long>(expected_latency));
+        result.failures.push_back(text);
+    }
+
+    // 其他通道的Note Off不释放第1通道的A4，打击乐通道的Note On被忽略（输出不变）
+    static const uint8_t OTHER_CHANNELS[] = {0x81, 69, 0, 0x99, 36, 100};
+    input.receive(OTHER_CHANNELS, sizeof(OTHER_CHANNELS), static_cast<uint32_t>(offline->getTimestampUs()));
+    offline->render(BLOCK * 39);
+
+    static const uint8_t ALL_NOTES_OFF[] = {0xB0, 123, 0};
+    input.receive(ALL_NOTES_OFF, sizeof(ALL_NOTES_OFF), static_cast<uint32_t>(offline->getTimestampUs()));
+    offline->render(BLOCK * 60);
+
+    // 零相位正弦、无Attack：第一个音符从第一个块的第1个采样开始非0
+    std::vector<int16_t> pcm = offline->getCapturedSamples();
+    if (pcm.size() < 4 || pcm[0] != 0 || pcm[2] == 0) {
+        result.failures.push_back("第一个音符未在音频流开始处发声");
+    }
+    if (input.droppedCount() != 0) {
+        result.failures.push_back("MIDI输入队列丢弃了消息");
+    }
+    if (pcm.back() != 0) {
+        result.failures.push_back("All Notes Off后仍有声音");
+    }
+
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+    return result;
+}
+
+/**
+ * @brief 序列完成场景：非循环序列播放完后由process()停止音频流并报告一次完成
+ * 旧序列的完成不能停止随后开始的新序列
+ */
+CaseResult runSequenceFinishedCase() {
+    CaseResult result;
+    result.name = "api/sequence_finished";
+
+    static constexpr NoteEvent FIRST[] = {
+        makeNoteEvent(Notes::C4, 20, 5), makeNoteEvent(Notes::E4, 20),
+    };
+    static constexpr NoteEvent SECOND[] = {
+        makeNoteEvent(Notes::G4, 30, 5), makeNoteEvent(Notes::C4, 30),
+    };
+    constexpr uint16_t BLOCK = 128;
+
+    OfflineApi fixture = makeOfflineApi(offlineConfig(1, BLOCK), result.failures);
+    if (!fixture.api) return result;
+    AudioAPI& api = *fixture.api;
+    OfflineAudioCore* offline = fixture.core;
+    offline->setCaptureEnabled(true);
+    api.setWaveType(WaveType::TRIANGLE);
+
+    // 第一段播放完成但主循环尚未处理时开始第二段
+    api.playSequence(EventSequence(FIRST), false);
+    offline->render(SAMPLE_RATE / 10);
+    api.playSequence(EventSequence(SECOND), false);
+    api.process();
+    if (!offline->isRunning()) {
+        result.failures.push_back("上一段序列的完成停止了新序列");
+    }
+
+    offline->render(SAMPLE_RATE / 10);
+    api.process();
+    if (offline->isRunning()) {
+        result.failures.push_back("序列完成后音频流未停止");
+    }
+    api.process();
+
+    size_t finished = 0;
+    AudioEventRecord record;
+    while (api.pollEvents(record)) {
+        if (record.code == AudioEventCode::SEQUENCE_FINISHED) ++finished;
+    }
+    if (finished != 1) {
+        result.failures.push_back("序列完成事件的次数不正确");
+    }
+
+    const std::vector<int16_t>& pcm = offline->getCapturedSamples();
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+    return result;
+}
+
+/**
+ * @brief 异步回调下的命令队列检查（不产生音频）
+ * 离线核心模拟core1模式：音频流运行时命令经队列在块边界应用；
+ * 停止期间的命令直接生效，不会填满队列，之后的playSequence()不受影响；
+ * 播放状态由应用命令的一方发布，控制端读取时不访问音序器
+ */
+CaseResult runCommandQueueCheck() {
+    CaseResult result;
+    result.name = "api/command_queue";
+    result.audio = false;
+
+    static constexpr NoteEvent MELODY[] = {
+        makeNoteEvent(Notes::C4, 20, 5), makeNoteEvent(Notes::E4, 20),
+    };
+    OfflineApi fixture = makeOfflineApi(offlineConfig(1, 128), result.failures);
+    if (!fixture.api) return result;
+    AudioAPI& api = *fixture.api;
+    OfflineAudioCore* offline = fixture.core;
+    offline->setCallbackAsync(true);
+
+    // 停止期间的调用远多于队列容量（noteOff()在命令被拒绝时返回false）
+    size_t rejected = 0;
+    for (int i = 0; i < 40; ++i) {
+        api.setVolume(static_cast<uint8_t>(i));
+        api.setWaveType(i % 2 ? WaveType::SQUARE : WaveType::SINE);
+        rejected += api.noteOff(60) ? 0 : 1;
+    }
+    if (rejected != 0) {
+        result.failures.push_back("音频流停止时命令队列被填满");
+    }
+    if (!api.playSequence(EventSequence(MELODY), false) || !offline->isRunning()) {
+        result.failures.push_back("停止期间的命令之后playSequence()失败");
+    }
+    // 播放状态在playSequence()返回时即已发布，不依赖渲染端取走命令
+    if (!api.isPlaying()) {
+        result.failures.push_back("playSequence()返回后isPlaying()为false");
+    }
+
+    // 运行期间命令只在块边界取出：不渲染时队列会满
+    for (int i = 0; i < 40; ++i) {
+        rejected += api.noteOff(60) ? 0 : 1;
+    }
+    if (rejected == 0) {
+        result.failures.push_back("音频流运行时命令未经队列传递");
+    }
+
+    // 队列满时重新播放：停止后剩余命令被直接应用，新序列照常启动
+    if (!api.playSequence(EventSequence(MELODY), false) || !offline->isRunning()) {
+        result.failures.push_back("命令队列满后playSequence()失败");
+    }
+    offline->render(SAMPLE_RATE / 10);
+    api.process();
+    if (offline->isRunning() || api.getPlaybackState() != PlaybackState::STOPPED) {
+        result.failures.push_back("序列完成后音频流未停止");
+    }
+
+    api.playSequence(EventSequence(MELODY), true);
+    offline->render(128);
+    api.stop();
+    if (api.isPlaying() || api.getPlaybackState() != PlaybackState::STOPPED) {
+        result.failures.push_back("stop()返回后播放状态不是STOPPED");
+    }
+    return result;
+}
+
+/**
+ * @brief 事件消息格式化检查（不产生音频）
+ * 消息只在formatEvent()中生成
+ */
+CaseResult runEventFormatCheck() {
+    CaseResult result;
+    result.name = "events/format";
+    result.audio = false;
+
+    // 消息按需格式化，截断时仍以'\0'结尾并返回完整长度
+    char text[64];
+    AudioEventRecord record;
+    record.code = AudioEventCode::WAVE_TYPE_CHANGED;
+    record.value = static_cast<int32_t>(WaveType::PIANO);
+    size_t length = formatEvent(record, text, sizeof(text));
+    if (std::strcmp(text, "波形类型已设置: 钢琴音色") != 0 || length != std::strlen(text)) {
+        result.failures.push_back("事件消息格式化错误");
+    }
+    char small[4];
+    if (formatEvent(record, small, sizeof(small)) != length || small[3] != '\0') {
+        result.failures.push_back("事件消息截断错误");
+    }
+    return result;
+}
+
+/**
+ * @brief 事件环场景：循环播放时渲染端记录循环事件
+ * 要求产生事件时不分配内存；pollEvents()按时间戳合并控制端与渲染端的记录；
+ * 设置回调后由process()投递；队列满时计数丢弃
+ */
+CaseResult runEventRingCase() {
+    CaseResult result;
+    result.name = "api/event_ring";
+
+    static constexpr NoteEvent LOOP[] = {
+        makeNoteEvent(Notes::A4, 50, 10), makeNoteEvent(Notes::E4, 50, 10),
+    };
+    constexpr uint16_t BLOCK = 128;
+    constexpr size_t LOOP_FRAMES = SAMPLE_RATE * 120 / 1000;
+
+    OfflineApi fixture = makeOfflineApi(offlineConfig(1, BLOCK), result.failures);
+    if (!fixture.api) return result;
+    AudioAPI& api = *fixture.api;
+    OfflineAudioCore* offline = fixture.core;
+    api.setWaveType(WaveType::PIANO);
+    api.playSequence(EventSequence(LOOP), true);
+
+    size_t allocations = g_allocations;
+    offline->render(LOOP_FRAMES * 3);
+    if (g_allocations != allocations) {
+        result.failures.push_back("渲染端记录事件时分配了内存");
+    }
+
+    const AudioEventCode EXPECTED[] = {
+        AudioEventCode::WAVE_TYPE_CHANGED, AudioEventCode::STOPPED, AudioEventCode::SEQUENCE_STARTED,
+    };
+    AudioEventRecord record;
+    size_t count = 0;
+    size_t loops = 0;
+    uint32_t last_timestamp = 0;
+    while (api.pollEvents(record)) {
+        if (count < std::size(EXPECTED)) {
+            if (record.code != EXPECTED[count] || record.timestamp_us != 0) {
+                result.failures.push_back("控制端事件的顺序或时间戳不正确");
+            }
+        } else if (record.code == AudioEventCode::SEQUENCE_LOOPED) {
+            if (record.timestamp_us <= last_timestamp || record.event() != AudioEvent::PLAYBACK_STARTED) {
+                result.failures.push_back("循环事件的时间戳未递增");
+            }
+            ++loops;
+        } else {
+            result.failures.push_back("出现了意外的事件");
+        }
+        last_timestamp = record.timestamp_us;
+        ++count;
+    }
+    if (loops < 2) {
+        result.failures.push_back("渲染端未记录序列循环");
+    }
+
+    // 回调在process()中投递
+    std::vector<AudioEventData> delivered;
+    api.setEventCallback([&delivered](const AudioEventData& event) { delivered.push_back(event); });
+    api.setVolume(40);
+    if (!delivered.empty()) {
+        result.failures.push_back("回调在产生事件的调用内部执行");
+    }
+    api.process();  // 离线核心在此渲染一个块，可能同时投递循环事件
+    size_t volume_events = 0;
+    for (const auto& event : delivered) {
+        if (event.code != AudioEventCode::VOLUME_CHANGED) continue;
+        ++volume_events;
+        if (event.event != AudioEvent::VOLUME_CHANGED || event.value != 40 || event.message != "音量已设置: 40") {
+            result.failures.push_back("回调收到的音量事件内容不正确");
+        }
+    }
+    if (volume_events != 1) {
+        result.failures.push_back("回调未收到音量事件");
+    }
+    api.setEventCallback(nullptr);
+
+    // 不取出事件时队列满后丢弃并计数
+    for (int i = 0; i < 20; ++i) {
+        api.setVolume(static_cast<uint8_t>(i));
+    }
+    if (api.getDroppedEventCount() != 4) {
+        result.failures.push_back("事件队列满时的丢弃计数不正确");
+    }
+    while (api.pollEvents(record)) {}
+
+    offline->setCaptureEnabled(true);
+    offline->render(LOOP_FRAMES * 2);
+    std::vector<int16_t> pcm = offline->getCapturedSamples();
+
+    result.samples = pcm.size();
+    result.hash = fnv1a(pcm);
+    return result;
+}
+
+// ==============================================================================
+// 黄金文件
+// ==============================================================================
+
+struct GoldenEntry {
+    size_t samples;
+    uint64_t hash;
+};
+
+/**
+ * @brief 读取黄金文件（每行：场景名 采样数 哈希，#开头为注释）
+ */
+bool loadGolden(const char* path, std::map<std::string, GoldenEntry>& golden) {
+    std::FILE* file = std::fopen(path, "r");
+    if (!file) return false;
+
+    char line[256];
+    while (std::fgets(line, sizeof(line), file)) {
+        char name[128];
+        size_t samples;
+        unsigned long long hash;
+        if (line[0] == '#') continue;
+        if (std::sscanf(line, "%127s %zu %llx", name, &samples, &hash) == 3) {
+            golden[name] = {samples, static_cast<uint64_t>(hash)};
+        }
+    }
+    std::fclose(file);
+    return true;
+}
+
+bool saveGolden(const char* path, const std::vector<CaseResult>& results) {
+    std::FILE* file = std::fopen(path, "w");
+    if (!file) return false;
+
+    std::fprintf(file, "# 黄金音频哈希（由 golden_audio_test --update 生成）\n");
+    std::fprintf(file, "# 场景名 采样数 FNV-1a(小端int16 PCM)\n");
+    for (const auto& result : results) {
+        if (!result.audio) continue;
+        std::fprintf(file, "%s %zu %016llx\n", result.name.c_str(), result.samples,
+                     static_cast<unsigned long long>(result.hash));
+    }
+    std::fclose(file);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::printf("用法: %s <黄金文件> [--update]\n", argv[0]);
+        return 2;
+    }
+    const char* golden_path = argv[1];
+    bool update = argc > 2 && std::strcmp(argv[2], "--update") == 0;
+
+    std::vector<CaseResult> results;
+    for (const auto& wave : WAVE_CASES) {
+        for (const auto& script : ENVELOPE_SCRIPTS) {
+            results.push_back(runGeneratorCase(wave, script));
+        }
+    }
+    for (const auto& wave : WAVE_CASES) {
+        results.push_back(runDoReMiCase(wave));
+    }
+    results.push_back(runVoiceStealCase());
+    results.push_back(runPitchTableCase());
+    results.push_back(runNoteLiteralCheck());
+    results.push_back(runPitchBendCase());
+    results.push_back(runWaveSwitchCase());
+    results.push_back(runWavetableCase());
+    results.push_back(runTempoCase());
+    results.push_back(runZeroLengthNotesCheck());
+    results.push_back(runMidiFileCase());
+    results.push_back(runMidiParserCheck());
+    results.push_back(runMidiInputCase());
+    results.push_back(runEventFormatCheck());
+    results.push_back(runEventRingCase());
+    results.push_back(runSequenceFinishedCase());
+    results.push_back(runCommandQueueCheck());
+
+    std::map<std::string, GoldenEntry> golden;
+    if (!update && !loadGolden(golden_path, golden)) {
+        std::printf("无法读取黄金文件: %s\n", golden_path);
+        return 1;
+    }
+
+    int failures = 0;
+    for (auto& result : results) {
+        if (!update && result.audio) {
+            auto it = golden.find(result.name);
+            if (it == golden.end()) {
+                result.failures.push_back("黄金文件中没有此场景");
+            } else if (it->second.samples != result.samples || it->second.hash != result.hash) {
+                char message[96];
+                std::snprintf(message, sizeof(message), "哈希不一致: 期望 %016llx，实际 %016llx",
+                              static_cast<unsigned long long>(it->second.hash),
+                              static_cast<unsigned long long>(result.hash));
+                result.failures.push_back(message);
+            }
+        }
+
+        char snr[16] = "-";
+        if (!std::isnan(result.snr_db)) {
+            std::snprintf(snr, sizeof(snr), "%.1f dB", result.snr_db);
+        }
+        char hash[20] = "-";
+        if (result.audio) {
+            std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(result.hash));
+        }
+        std::printf("%-4s %-32s %8zu %16s %10s\n", result.failures.empty() ? "OK" : "FAIL",
+                    result.name.c_str(), result.samples, hash, snr);
+        for (const auto& failure : result.failures) {
+            std::printf("       %s\n", failure.c_str());
+        }
+        failures += result.failures.empty() ? 0 : 1;
+    }
+
+    if (update) {
+        // 容差检查失败时不覆盖黄金文件
+        if (failures > 0 || !saveGolden(golden_path, results)) {
+            std::printf("未更新黄金文件\n");
+            return 1;
+        }
+        std::printf("已更新: %s\n", golden_path);
+        return 0;
+    }
+
+    std::printf("%zu个场景，%d个失败\n", results.size(), failures);
+    return failures > 0 ? 1 : 0;
+}